@@ -0,0 +1,218 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Measures the run-time overhead of EXPECT_REGULAR. Usage:
+//
+//   check_overhead
+//
+// For a number of types, prints the nanoseconds and the allocations per check,
+// for each of the checks of RegularTypeChecker, for RegularTypeChecker::Check()
+// as a whole, and for the complete CheckRegularType call of EXPECT_REGULAR
+// (including the construction of the checker, and the test property). Compares
+// them with a handwritten check, which does the same operations without
+// building any message. The numbers are only meaningful for an optimized
+// build, for example with CMAKE_BUILD_TYPE=Release.
+
+// For MeasureNanosecondsPerCall:
+#include "example_implementation/gtest-regular-complexity.h"
+#include "example_implementation/gtest-regular.h"
+
+// GoogleTest header file:
+#include <gtest/internal/gtest-type-util.h>  // For GetTypeName.
+
+// Standard library header files:
+#include <cstddef>  // For size_t.
+#include <cstdio>   // For printf.
+#include <string>
+#include <utility>  // For move.
+#include <vector>
+
+namespace {
+
+using example_implementation_by_niels_dekker::AllocationCounter;
+using example_implementation_by_niels_dekker::CheckRegularType;
+using example_implementation_by_niels_dekker::MeasureNanosecondsPerCall;
+using example_implementation_by_niels_dekker::RegularTypeChecker;
+using example_implementation_by_niels_dekker::RegularTypeThunks;
+
+// A plain old data type that is too large to be stored inside the buffer of
+// RegularTypeChecker::Object.
+struct LargePod {
+  int data[256];
+
+  bool operator==(const LargePod& other) const {
+    for (std::size_t i{}; i < sizeof(data) / sizeof(data[0]); ++i) {
+      if (data[i] != other.data[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  bool operator!=(const LargePod& other) const { return !(*this == other); }
+};
+
+// Does the same operations as RegularTypeChecker::Check(), for two example
+// values, without building any message.
+template <typename T>
+bool CheckHandwritten(const T& value1, const T& value2) {
+  if (!(T{} == T{}) || T{} != T{}) {
+    return false;
+  }
+  const T* const values[] = {&value1, &value2};
+
+  for (std::size_t i{}; i < 2; ++i) {
+    const T& value = *values[i];
+    const T& other = *values[1 - i];
+
+    if (!(value == value) || value != value || value == other ||
+        !(value != other)) {
+      return false;
+    }
+
+    T copy(value);
+    const T moved(std::move(copy));
+    T target(other);
+    target = value;
+
+    if (moved != value || target != value) {
+      return false;
+    }
+    target = other;
+    target = std::move(copy = value);
+
+    if (target != value) {
+      return false;
+    }
+    const T& self = target;
+    target = self;
+
+    if (target != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Function>
+void PrintMeasurement(const char* const name, const Function& function,
+                      const std::size_t calls_per_function) {
+  const double nanoseconds = MeasureNanosecondsPerCall(
+      function, static_cast<unsigned>(calls_per_function));
+
+  const AllocationCounter counter;
+  function();
+  const double allocations =
+      static_cast<double>(counter.GetCount().allocations) /
+      static_cast<double>(calls_per_function);
+
+  std::printf("  %-32s %12.1f %12.1f\n", name, nanoseconds, allocations);
+}
+
+template <typename T>
+void MeasureCheckOverhead(const char* const description, const T& value1,
+                          const T& value2) {
+  std::printf("\n%s (%s)\n  %-32s %12s %12s\n", description,
+              testing::internal::GetTypeName<T>().c_str(), "Check",
+              "ns/check", "allocs/check");
+
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &value1, "value1", &value2, "value2",
+                                   message);
+  const std::vector<RegularTypeChecker::Task> tasks = checker.GetTasks();
+
+  // Measure the tasks that have the same name (but different examples)
+  // together.
+  for (std::size_t begin{}; begin < tasks.size();) {
+    std::size_t end{begin + 1};
+
+    while (end < tasks.size() &&
+           std::string(tasks[end].name) == tasks[begin].name) {
+      ++end;
+    }
+    PrintMeasurement(
+        tasks[begin].name,
+        [&checker, &tasks, begin, end] {
+          for (std::size_t i{begin}; i < end; ++i) {
+            tasks[i].run(checker);
+          }
+        },
+        end - begin);
+    begin = end;
+  }
+
+  PrintMeasurement(
+      "RegularTypeChecker::Check",
+      [&value1, &value2] {
+        std::string message;
+        const RegularTypeChecker checker(
+            RegularTypeThunks<T>::GetOperations(), &value1, "value1", &value2,
+            "value2", message);
+        checker.Check();
+      },
+      1);
+  PrintMeasurement("CheckRegularType",
+                   [&value1, &value2] {
+                     CheckRegularType<false>(__FILE__, __LINE__, value1,
+                                             "value1", value2, "value2");
+                   },
+                   1);
+  PrintMeasurement("Handwritten",
+                   [&value1, &value2] {
+                     volatile bool is_regular{};
+                     is_regular = CheckHandwritten(value1, value2);
+                     static_cast<void>(is_regular);
+                   },
+                   1);
+}
+
+}  // namespace
+
+int main() {
+#ifndef NDEBUG
+  std::printf("Warning: NDEBUG is not defined. Is this an optimized build?\n");
+#endif
+  MeasureCheckOverhead("int", 1, 2);
+  MeasureCheckOverhead("Short string", std::string("a"), std::string("b"));
+  MeasureCheckOverhead("Long string", std::string(100, 'a'),
+                       std::string(100, 'b'));
+
+  for (const std::size_t size : {1, 16, 256, 4096}) {
+    const std::string description = "Vector of size " + std::to_string(size);
+    MeasureCheckOverhead(description.c_str(), std::vector<int>(size, 1),
+                         std::vector<int>(size, 2));
+  }
+
+  LargePod large_pod1{};
+  LargePod large_pod2{};
+  large_pod2.data[0] = 1;
+  MeasureCheckOverhead("Large POD", large_pod1, large_pod2);
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Implements a compiler launcher for the compile-cost benchmark of
+// gtest-regular. Usage:
+//
+//   compile_cost_launcher <compiler> <compiler arguments>...
+//
+// Runs the compiler, and prints its wall-clock time, its peak memory usage
+// (when supported by the platform) and the size of the object file that it
+// produced. The object file is specified by "-o" (or "/Fo" for Visual C++).
+
+// Standard library header files:
+#include <chrono>    // For steady_clock.
+#include <cstdlib>   // For EXIT_FAILURE.
+#include <cstring>   // For strcmp and strncmp.
+#include <fstream>   // For ifstream.
+#include <iostream>  // For cout and cerr.
+#include <string>
+
+#ifdef _WIN32
+#include <process.h>  // For _spawnvp.
+#else
+#include <sys/resource.h>  // For getrusage.
+#include <sys/wait.h>      // For waitpid.
+#include <unistd.h>        // For execvp and fork.
+#endif
+
+namespace {
+
+// Runs the specified command, and returns its exit code, or -1 when the
+// command could not be run.
+int RunCommand(char** const command) {
+#ifdef _WIN32
+  return static_cast<int>(_spawnvp(_P_WAIT, command[0], command));
+#else
+  const pid_t pid = fork();
+
+  if (pid == 0) {
+    execvp(command[0], command);
+    std::cerr << "Failed to run " << command[0] << '\n';
+    _exit(EXIT_FAILURE);
+  }
+  int status{};
+
+  if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+    return -1;
+  }
+  return WEXITSTATUS(status);
+#endif
+}
+
+// Returns the peak resident memory (in kilobytes) of the child processes that
+// have terminated, as a string.
+std::string GetPeakMemoryOfChildProcesses() {
+#ifdef _WIN32
+  return "n/a";
+#else
+  rusage usage{};
+
+  if (getrusage(RUSAGE_CHILDREN, &usage) != 0) {
+    return "n/a";
+  }
+#ifdef __APPLE__
+  // On macOS, ru_maxrss is specified in bytes, rather than kilobytes.
+  return std::to_string(usage.ru_maxrss / 1024) + " KB";
+#else
+  return std::to_string(usage.ru_maxrss) + " KB";
+#endif
+#endif
+}
+
+std::string GetObjectFileName(const int argc, char** const argv) {
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      return argv[i + 1];
+    }
+    if (std::strncmp(argv[i], "-o", 2) == 0) {
+      return argv[i] + 2;
+    }
+    if (std::strncmp(argv[i], "/Fo", 3) == 0) {
+      return argv[i] + 3;
+    }
+  }
+  return {};
+}
+
+std::string GetFileSize(const std::string& file_name) {
+  std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+
+  return file ? std::to_string(file.tellg()) + " bytes" : "n/a";
+}
+
+}  // namespace
+
+int main(const int argc, char** const argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <compiler> <compiler arguments>\n";
+    return EXIT_FAILURE;
+  }
+
+  const auto start_time = std::chrono::steady_clock::now();
+  const int exit_code = RunCommand(argv + 1);
+  const std::chrono::duration<double> wall_time =
+      std::chrono::steady_clock::now() - start_time;
+
+  if (exit_code != 0) {
+    return exit_code < 0 ? EXIT_FAILURE : exit_code;
+  }
+  const std::string object_file_name = GetObjectFileName(argc, argv);
+
+  std::cout << "Compile cost of " << object_file_name
+            << "\n  Wall time: " << wall_time.count()
+            << " s\n  Peak memory: " << GetPeakMemoryOfChildProcesses()
+            << "\n  Object size: " << GetFileSize(object_file_name) << '\n';
+  return 0;
+}
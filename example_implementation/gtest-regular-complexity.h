@@ -0,0 +1,411 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro's EXPECT_REGULAR_COMPLEXITY(generator)
+// and ASSERT_REGULAR_COMPLEXITY(generator), which estimate the time complexity
+// of copying, moving and comparing values of a type, produced by a generator
+// of the form `T generator(std::size_t size)`.
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_COMPLEXITY_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_COMPLEXITY_H_
+
+#include <chrono>       // For steady_clock.
+#include <cmath>        // For log and pow.
+#include <cstddef>      // For size_t.
+#include <limits>       // For numeric_limits.
+#include <new>          // For placement new.
+#include <sstream>      // For ostringstream.
+#include <string>
+#include <type_traits>  // For aligned_storage and decay.
+#include <utility>      // For move.
+#include <vector>
+
+#include "gtest-regular.h"  // For ReportFailure.
+#include "gtest/gtest.h"    // For Test::RecordProperty.
+#include "gtest/internal/gtest-type-util.h"  // For GetTypeName.
+
+namespace example_implementation_by_niels_dekker {
+
+// Options of the complexity analysis. The values produced by the generator
+// are measured for the sizes min_size, min_size * growth_factor, etc., up to
+// and including max_size.
+struct ComplexityOptions {
+  std::size_t min_size = 16;
+  std::size_t max_size = std::size_t{1} << 16;
+  std::size_t growth_factor = 4;
+
+  // An operation is assumed to take constant time when the estimated exponent
+  // of its time complexity, O(n^exponent), is less than this threshold.
+  double max_constant_time_exponent = 0.5;
+};
+
+// Returns the minimum number of nanoseconds per call, over a number of
+// trials. Each trial repeats the specified round (which does a number of
+// calls) until it has taken sufficiently long to be measured accurately.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename Round>
+double MeasureNanosecondsPerCall(const Round& round,
+                                 const unsigned calls_per_round) {
+  using Clock = std::chrono::steady_clock;
+  constexpr unsigned trial_count{5};
+  const auto minimum_trial_duration = std::chrono::microseconds(200);
+
+  double result = std::numeric_limits<double>::max();
+
+  for (unsigned trial{}; trial < trial_count; ++trial) {
+    for (std::size_t round_count{1};; round_count *= 2) {
+      const auto start_time = Clock::now();
+
+      for (std::size_t i{}; i < round_count; ++i) {
+        round();
+      }
+      const auto duration = Clock::now() - start_time;
+
+      if (duration >= minimum_trial_duration) {
+        const double nanoseconds = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+                .count());
+        const double nanoseconds_per_call =
+            nanoseconds / static_cast<double>(round_count * calls_per_round);
+
+        if (nanoseconds_per_call < result) {
+          result = nanoseconds_per_call;
+        }
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+// Estimates the time complexity of the operations that RegularTypeChecker
+// exercises, for values of different sizes, produced by a generator.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T, typename Generator>
+class ComplexityAnalyzer {
+ public:
+  ComplexityAnalyzer(Generator& generator,
+                     const char* const generator_expression,
+                     const ComplexityOptions& options, std::string& message)
+      : generator_(generator),
+        generator_expression_(generator_expression),
+        options_(options),
+        message_(message) {}
+
+  // Measures each operation, records the estimated exponents as test
+  // properties, and checks that moves, and comparing values of different
+  // sizes, take constant time.
+  bool Check() const {
+    // Checks the options before using them, as a zero min_size, or a
+    // growth_factor less than 2, would make the following loop endless.
+    if (options_.min_size == 0 || options_.growth_factor < 2) {
+      message_.append(
+          "ComplexityOptions should specify a min_size greater than zero, and "
+          "a growth_factor of at least 2!");
+      return false;
+    }
+    std::vector<std::size_t> sizes;
+
+    for (std::size_t size = options_.min_size; size <= options_.max_size;
+         size *= options_.growth_factor) {
+      sizes.push_back(size);
+
+      // Stops before the multiplication by growth_factor would overflow.
+      if (size > std::numeric_limits<std::size_t>::max() /
+                     options_.growth_factor) {
+        break;
+      }
+    }
+    if (sizes.size() < 4) {
+      message_.append(
+          "ComplexityOptions should specify at least four different sizes!");
+      return false;
+    }
+
+    std::vector<Measurement> measurements;
+
+    for (const std::size_t size : sizes) {
+      const T value = generator_(size);
+      const T value_of_other_size = generator_(size + 1);
+
+      if (Operations::Equal(value, value_of_other_size)) {
+        message_.append("The generator should produce different values for ")
+            .append("different sizes!\n    Generator: ")
+            .append(generator_expression_)
+            .append("\n    Sizes: ")
+            .append(std::to_string(size))
+            .append(" and ")
+            .append(std::to_string(size + 1));
+        return false;
+      }
+      measurements.push_back(Measure(value, value_of_other_size));
+    }
+
+    const double exponents[] = {
+        EstimateExponent(sizes, measurements, &Measurement::copy_construction),
+        EstimateExponent(sizes, measurements, &Measurement::copy_assignment),
+        EstimateExponent(sizes, measurements, &Measurement::move_construction),
+        EstimateExponent(sizes, measurements, &Measurement::move_assignment),
+        EstimateExponent(sizes, measurements, &Measurement::equal_values),
+        EstimateExponent(sizes, measurements,
+                         &Measurement::values_of_different_size)};
+
+    static const char* const operation_names[] = {
+        "copy_construction", "copy_assignment", "move_construction",
+        "move_assignment",   "equal_values",    "values_of_different_size"};
+
+    for (std::size_t i{}; i < sizeof(exponents) / sizeof(exponents[0]); ++i) {
+      ::testing::Test::RecordProperty(
+          std::string("complexity.") + operation_names[i],
+          ToComplexityString(exponents[i]));
+    }
+
+    return CheckConstantTime("Move-construction", exponents[2], sizes,
+                             measurements, &Measurement::move_construction) &&
+           CheckConstantTime("Move-assignment", exponents[3], sizes,
+                             measurements, &Measurement::move_assignment) &&
+           CheckConstantTime("Comparing values of different sizes by `==`",
+                             exponents[5], sizes, measurements,
+                             &Measurement::values_of_different_size);
+  }
+
+ private:
+  // Nanoseconds per call of each operation, for a specific size.
+  struct Measurement {
+    double copy_construction;
+    double copy_assignment;
+    double move_construction;
+    double move_assignment;
+    double equal_values;
+    double values_of_different_size;
+  };
+
+  using Storage =
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+  // The operations are called through (volatile) function pointers, so that
+  // the compiler cannot optimize them away.
+  struct Operations {
+    static void CopyConstruct(void* const target, const T& source) {
+      ::new (target) T(source);
+    }
+    static void MoveConstruct(void* const target, T& source) {
+      ::new (target) T(std::move(source));
+    }
+    static void CopyAssign(T& target, const T& source) { target = source; }
+    static void MoveAssign(T& target, T& source) { target = std::move(source); }
+    static void Destruct(T& object) { object.~T(); }
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+    static bool Equal(const T& left_operand, const T& right_operand) {
+      return left_operand == right_operand;
+    }
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+  };
+
+  static Measurement Measure(const T& value, const T& value_of_other_size) {
+    void (*volatile copy_construct)(void*, const T&) =
+        &Operations::CopyConstruct;
+    void (*volatile move_construct)(void*, T&) = &Operations::MoveConstruct;
+    void (*volatile copy_assign)(T&, const T&) = &Operations::CopyAssign;
+    void (*volatile move_assign)(T&, T&) = &Operations::MoveAssign;
+    void (*volatile destruct)(T&) = &Operations::Destruct;
+    bool (*volatile equal)(const T&, const T&) = &Operations::Equal;
+    volatile bool is_equal{};
+
+    Storage storage1;
+    Storage storage2;
+    T& object1 = *reinterpret_cast<T*>(&storage1);
+    T& object2 = *reinterpret_cast<T*>(&storage2);
+
+    Measurement measurement;
+
+    measurement.copy_construction = MeasureNanosecondsPerCall(
+        [&] {
+          copy_construct(&storage1, value);
+          destruct(object1);
+        },
+        1);
+
+    {
+      T target(value);
+      measurement.copy_assignment = MeasureNanosecondsPerCall(
+          [&] { copy_assign(target, value); }, 1);
+    }
+
+    // Move the value back and forth between the two storage buffers.
+    copy_construct(&storage1, value);
+    measurement.move_construction = MeasureNanosecondsPerCall(
+        [&] {
+          move_construct(&storage2, object1);
+          destruct(object1);
+          move_construct(&storage1, object2);
+          destruct(object2);
+        },
+        2);
+    destruct(object1);
+
+    {
+      T object(value);
+      T other_object;
+      measurement.move_assignment = MeasureNanosecondsPerCall(
+          [&] {
+            move_assign(other_object, object);
+            move_assign(object, other_object);
+          },
+          2);
+    }
+    {
+      const T copy(value);
+      measurement.equal_values = MeasureNanosecondsPerCall(
+          [&] { is_equal = equal(value, copy); }, 1);
+    }
+    measurement.values_of_different_size = MeasureNanosecondsPerCall(
+        [&] { is_equal = equal(value, value_of_other_size); }, 1);
+
+    return measurement;
+  }
+
+  // Estimates the exponent of O(n^exponent) by a least-squares fit of the
+  // logarithm of the measured time against the logarithm of the size. Only
+  // the largest half of the sizes is used, as the time for small sizes tends
+  // to be dominated by constant overhead (like the call of malloc).
+  static double EstimateExponent(const std::vector<std::size_t>& sizes,
+                                 const std::vector<Measurement>& measurements,
+                                 double Measurement::*const operation) {
+    const std::size_t first_index = sizes.size() / 2;
+    const double count = static_cast<double>(sizes.size() - first_index);
+    double sum_x{};
+    double sum_y{};
+    double sum_xx{};
+    double sum_xy{};
+
+    for (std::size_t i{first_index}; i < sizes.size(); ++i) {
+      const double x = std::log(static_cast<double>(sizes[i]));
+      // Add one nanosecond, to avoid taking the logarithm of zero.
+      const double y = std::log(measurements[i].*operation + 1.0);
+      sum_x += x;
+      sum_y += y;
+      sum_xx += x * x;
+      sum_xy += x * y;
+    }
+    return (count * sum_xy - sum_x * sum_y) / (count * sum_xx - sum_x * sum_x);
+  }
+
+  static std::string ToComplexityString(const double exponent) {
+    std::ostringstream stream;
+    stream.precision(2);
+    stream << "O(n^" << std::fixed << exponent << ')';
+    return stream.str();
+  }
+
+  bool CheckConstantTime(const char* const operation_name,
+                         const double exponent,
+                         const std::vector<std::size_t>& sizes,
+                         const std::vector<Measurement>& measurements,
+                         double Measurement::*const operation) const {
+    if (exponent < options_.max_constant_time_exponent) {
+      return true;
+    }
+    message_.append(operation_name)
+        .append(" should take constant time, but appears to take ")
+        .append(ToComplexityString(exponent))
+        .append(" time!\n    Generator: ")
+        .append(generator_expression_)
+        .append("\n    Nanoseconds per call, for each size:");
+
+    for (std::size_t i{}; i < sizes.size(); ++i) {
+      std::ostringstream stream;
+      stream.precision(1);
+      stream << std::fixed << measurements[i].*operation;
+      message_.append("\n      ")
+          .append(std::to_string(sizes[i]))
+          .append(": ")
+          .append(stream.str());
+    }
+    return false;
+  }
+
+  Generator& generator_;
+  const char* const generator_expression_;
+  const ComplexityOptions options_;
+  std::string& message_;
+};
+
+template <bool is_failure_fatal, typename Generator>
+void CheckComplexity(const char* const file, const int line,
+                     Generator&& generator,
+                     const char* const generator_expression,
+                     const ComplexityOptions& options = ComplexityOptions()) {
+  using T = typename std::decay<decltype(generator(std::size_t{}))>::type;
+  using GeneratorType = typename std::remove_reference<Generator>::type;
+
+  std::string message;
+  const ComplexityAnalyzer<T, GeneratorType> analyzer(
+      generator, generator_expression, options, message);
+
+  if (!analyzer.Check()) {
+    ReportFailure(
+        is_failure_fatal, file, line,
+        "Type expected to have constant-time moves and early-exit comparison "
+        "of values of different sizes: '" +
+            testing::internal::GetTypeName<T>() + "'\n  " + message);
+  }
+}
+
+}  // namespace example_implementation_by_niels_dekker
+
+#define EXPECT_REGULAR_COMPLEXITY(generator)                            \
+  ::example_implementation_by_niels_dekker::CheckComplexity<false>(     \
+      __FILE__, __LINE__, generator, #generator)
+
+#define ASSERT_REGULAR_COMPLEXITY(generator)                            \
+  ::example_implementation_by_niels_dekker::CheckComplexity<true>(      \
+      __FILE__, __LINE__, generator, #generator)
+
+// Variants of EXPECT_REGULAR_COMPLEXITY and ASSERT_REGULAR_COMPLEXITY that
+// allow specifying the sizes and the threshold by ComplexityOptions.
+#define EXPECT_REGULAR_COMPLEXITY_WITH_OPTIONS(generator, options)      \
+  ::example_implementation_by_niels_dekker::CheckComplexity<false>(     \
+      __FILE__, __LINE__, generator, #generator, options)
+
+#define ASSERT_REGULAR_COMPLEXITY_WITH_OPTIONS(generator, options)      \
+  ::example_implementation_by_niels_dekker::CheckComplexity<true>(      \
+      __FILE__, __LINE__, generator, #generator, options)
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_COMPLEXITY_H_
@@ -0,0 +1,276 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro's
+// EXPECT_REGULAR_CONCURRENT(example_value1, example_value2, thread_count) and
+// ASSERT_REGULAR_CONCURRENT(example_value1, example_value2, thread_count),
+// which copy, compare and hash the same const examples from a number of
+// threads at once, and check that the examples are not modified. They are meant
+// to detect hidden mutation of "read-only" objects, like mutable caches or
+// non-atomic reference counts. Running them under ThreadSanitizer (see the
+// GTEST_REGULAR_SANITIZER option of CMakeLists.txt) pins down the data race.
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_CONCURRENT_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_CONCURRENT_H_
+
+#include <atomic>      // For atomic.
+#include <cstddef>     // For size_t.
+#include <functional>  // For hash.
+#include <string>
+#include <thread>
+#include <type_traits>  // For false_type and true_type.
+#include <utility>      // For declval.
+#include <vector>
+
+#include "gtest-regular.h"  // For RegularTypeExample and ReportFailure.
+#include "gtest/internal/gtest-type-util.h"  // For GetTypeName.
+
+namespace example_implementation_by_niels_dekker {
+
+// Tells whether std::hash<T> is enabled (C++17 [unord.hash]).
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T, typename = void>
+struct IsStdHashable : std::false_type {};
+
+template <typename T>
+struct IsStdHashable<
+    T, decltype(void(std::hash<T>{}(std::declval<const T&>())))>
+    : std::true_type {};
+
+// Copies, compares and (when std::hash<T> is enabled) hashes the examples from
+// a number of threads at once, and checks that the results are consistent, and
+// that the examples are not modified. Reuses the two examples of a
+// RegularTypeChecker.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T>
+class ConcurrentAccessChecker {
+ public:
+  enum { kIterationsPerThread = 1000 };
+
+  ConcurrentAccessChecker(const std::vector<RegularTypeExample>& examples,
+                          const unsigned thread_count, std::string& message)
+      : examples_(examples),
+        thread_count_(thread_count),
+        message_(message) {}
+
+  bool Check() const {
+    if (thread_count_ < 2) {
+      message_.append("At least two threads are required!");
+      return false;
+    }
+
+    // Copies made beforehand, by a single thread.
+    const T original_values[] = {GetValue(0), GetValue(1)};
+    const std::size_t original_hash_values[] = {
+        Hash(GetValue(0), IsStdHashable<T>()),
+        Hash(GetValue(1), IsStdHashable<T>())};
+
+    Counters counters;
+    {
+      // Joins the threads, also when starting one of them throws an exception.
+      ThreadStarter starter{counters, {}};
+
+      for (unsigned i{}; i < thread_count_; ++i) {
+        starter.threads.emplace_back([this, &counters, &original_hash_values] {
+          AccessExamples(counters, original_hash_values);
+        });
+      }
+    }
+
+    const std::size_t copy_count =
+        std::size_t{thread_count_} * kIterationsPerThread * 2;
+
+    return CheckCount(counters.unequal_copy_count, copy_count,
+                      "Copies made concurrently should compare equal to the "
+                      "original!") &&
+           CheckCount(counters.unequal_hash_value_count, copy_count,
+                      "Copies made concurrently should have the same hash "
+                      "value as the original!") &&
+           CheckExample(0, original_values[0]) &&
+           CheckExample(1, original_values[1]);
+  }
+
+ private:
+  struct Counters {
+    std::atomic<bool> is_started{false};
+    std::atomic<std::size_t> unequal_copy_count{0};
+    std::atomic<std::size_t> unequal_hash_value_count{0};
+  };
+
+  // Holds the threads. Its destructor lets the threads start accessing the
+  // examples, and waits for them to finish.
+  struct ThreadStarter {
+    Counters& counters;
+    std::vector<std::thread> threads;
+
+    ~ThreadStarter() {
+      counters.is_started = true;
+
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+    }
+  };
+
+  static std::size_t Hash(const T& value, std::true_type /* is hashable */) {
+    return std::hash<T>{}(value);
+  }
+
+  static std::size_t Hash(const T&, std::false_type /* is hashable */) {
+    return 0;
+  }
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+  static bool Equal(const T& left_operand, const T& right_operand) {
+    return left_operand == right_operand && !(left_operand != right_operand);
+  }
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+  const T& GetValue(const std::size_t example_index) const {
+    return *static_cast<const T*>(examples_[example_index].GetValue());
+  }
+
+  // The function that is run by each thread. It only accesses the examples
+  // by const references.
+  void AccessExamples(Counters& counters,
+                      const std::size_t (&original_hash_values)[2]) const {
+    // Let the threads start accessing the examples at the same time.
+    while (!counters.is_started) {
+      std::this_thread::yield();
+    }
+    for (unsigned iteration{}; iteration < kIterationsPerThread; ++iteration) {
+      for (std::size_t i{}; i < 2; ++i) {
+        const T& value = GetValue(i);
+        T copy(value);
+
+        if (!Equal(copy, value)) {
+          ++counters.unequal_copy_count;
+        }
+        if (Hash(copy, IsStdHashable<T>()) != original_hash_values[i]) {
+          ++counters.unequal_hash_value_count;
+        }
+        copy = GetValue(1 - i);
+        copy = value;
+
+        if (!Equal(value, copy)) {
+          ++counters.unequal_copy_count;
+        }
+      }
+    }
+  }
+
+  bool CheckCount(const std::size_t count, const std::size_t total_count,
+                  const char* const short_message) const {
+    if (count == 0) {
+      return true;
+    }
+    message_.append(short_message)
+        .append("\n    Threads: ")
+        .append(std::to_string(thread_count_))
+        .append("\n    Failures: ")
+        .append(std::to_string(count))
+        .append(" of ")
+        .append(std::to_string(total_count))
+        .append("\n    First example: ")
+        .append(examples_[0].ToString())
+        .append("\n    Second example: ")
+        .append(examples_[1].ToString());
+    return false;
+  }
+
+  bool CheckExample(const std::size_t example_index,
+                    const T& original_value) const {
+    const RegularTypeExample& example = examples_[example_index];
+
+    if (example.IsModified() ||
+        !Equal(GetValue(example_index), original_value)) {
+      message_
+          .append(
+              "An example should not be modified by being copied and "
+              "compared from multiple threads!\n    Threads: ")
+          .append(std::to_string(thread_count_))
+          .append("\n    Example: ")
+          .append(example.ToString());
+      return false;
+    }
+    return true;
+  }
+
+  const std::vector<RegularTypeExample>& examples_;
+  const unsigned thread_count_;
+  std::string& message_;
+};
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeConcurrently(const char* const file, const int line,
+                                  const T& example_value1,
+                                  const char* const example_expression1,
+                                  const T& example_value2,
+                                  const char* const example_expression2,
+                                  const unsigned thread_count) {
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &example_value1, example_expression1,
+                                   &example_value2, example_expression2,
+                                   message);
+  const ConcurrentAccessChecker<T> concurrent_access_checker(
+      checker.GetExamples(), thread_count, message);
+
+  if (!(checker.Check() && concurrent_access_checker.Check())) {
+    ReportFailure(is_failure_fatal, file, line,
+                  "Type expected to be regular, also when accessed "
+                  "concurrently: '" +
+                      testing::internal::GetTypeName<T>() + "'\n  " + message);
+  }
+}
+
+}  // namespace example_implementation_by_niels_dekker
+
+#define EXPECT_REGULAR_CONCURRENT(example_value1, example_value2,          \
+                                  thread_count)                            \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeConcurrently<  \
+      false>(__FILE__, __LINE__, example_value1, #example_value1,          \
+             example_value2, #example_value2, thread_count)
+
+#define ASSERT_REGULAR_CONCURRENT(example_value1, example_value2,          \
+                                  thread_count)                            \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeConcurrently<  \
+      true>(__FILE__, __LINE__, example_value1, #example_value1,           \
+            example_value2, #example_value2, thread_count)
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_CONCURRENT_H_
@@ -0,0 +1,253 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro STATIC_ASSERT_REGULAR(example_value1,
+// example_value2), which checks at compile-time that a literal type is
+// regular, and the constexpr function IsRegularConstexpr(example_value1,
+// example_value2) that it is based on. Requires C++14 or later (relaxed
+// constexpr). For non-literal types, use EXPECT_REGULAR instead.
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_CONSTEXPR_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_CONSTEXPR_H_
+
+#include <utility>  // For move.
+
+#if defined(__cpp_constexpr) && (__cpp_constexpr >= 201304L)
+#define GTEST_REGULAR_HAS_CONSTEXPR_CHECKS 1
+#else
+#define GTEST_REGULAR_HAS_CONSTEXPR_CHECKS 0
+#endif
+
+#if GTEST_REGULAR_HAS_CONSTEXPR_CHECKS
+
+namespace example_implementation_by_niels_dekker {
+
+// Compile-time equivalent of the checks of RegularTypeChecker, without
+// failure messages (as those cannot be built at compile-time). Each check has
+// the name of its run-time counterpart, a member function of
+// RegularTypeChecker, defined in gtest-regular.cc. A change to a run-time
+// check should be applied to its compile-time counterpart as well.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T>
+class ConstexprRegularTypeChecker {
+ public:
+  static constexpr bool Check(const T& example_value1,
+                              const T& example_value2) {
+    return CheckEqualToSelf(example_value1) &&
+           CheckEqualToSelf(example_value2) &&
+           CheckUnequal(example_value1, example_value2) &&
+           CheckUnequal(example_value2, example_value1) &&
+           CheckValueInitialization() &&
+           CheckCopyAndMoveConstruct(example_value1, example_value2) &&
+           CheckCopyAndMoveConstruct(example_value2, example_value1) &&
+           CheckAssigningDifferentValue(example_value1, example_value2) &&
+           CheckAssigningDifferentValue(example_value2, example_value1) &&
+           CheckAssigningItsOriginalValue(example_value1) &&
+           CheckAssigningItsOriginalValue(example_value2) &&
+           CheckSelfAssignment(example_value1, example_value2) &&
+           CheckSelfAssignment(example_value2, example_value1) &&
+           CheckCopyValue(example_value1, example_value2) &&
+           CheckCopyValue(example_value2, example_value1);
+  }
+
+ private:
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+
+  static constexpr bool Equal(const T& left_operand, const T& right_operand) {
+    return left_operand == right_operand;
+  }
+
+  static constexpr bool Unequal(const T& left_operand,
+                                const T& right_operand) {
+    return left_operand != right_operand;
+  }
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+  // Tells whether the operands compare equal, by both `==` and `!=`.
+  static constexpr bool IsEqual(const T& left_operand,
+                                const T& right_operand) {
+    return Equal(left_operand, right_operand) &&
+           !Unequal(left_operand, right_operand);
+  }
+
+  // Tells whether the operands compare unequal, by both `==` and `!=`.
+  static constexpr bool IsUnequal(const T& left_operand,
+                                  const T& right_operand) {
+    return !Equal(left_operand, right_operand) &&
+           Unequal(left_operand, right_operand);
+  }
+
+  // Workaround for GCC warning: variable set but not used
+  // [-Werror=unused-but-set-variable]
+  static constexpr void DoNotUse(const T&) {}
+
+  // Counterpart of RegularTypeChecker::CheckEqualToSelf.
+  static constexpr bool CheckEqualToSelf(const T& value) {
+    return IsEqual(value, value);
+  }
+
+  // Counterpart of RegularTypeChecker::CheckUnequal.
+  static constexpr bool CheckUnequal(const T& left_operand,
+                                     const T& right_operand) {
+    return IsUnequal(left_operand, right_operand);
+  }
+
+  // Counterpart of RegularTypeChecker::CheckValueInitialization.
+  static constexpr bool CheckValueInitialization() {
+    return IsEqual(T(), T());
+  }
+
+  // Counterpart of RegularTypeChecker::CheckCopyAndMoveConstruct.
+  static constexpr bool CheckCopyAndMoveConstruct(const T& example_value,
+                                                  const T& other_value) {
+    const T copied_value(example_value);
+
+    if (!IsEqual(copied_value, example_value)) {
+      return false;
+    }
+    T non_const_lvalue(example_value);
+    const T moved_value(std::move(non_const_lvalue));
+
+    if (!IsEqual(moved_value, example_value)) {
+      return false;
+    }
+    non_const_lvalue = other_value;
+    return IsEqual(non_const_lvalue, other_value);
+  }
+
+  // Counterpart of RegularTypeChecker::CheckAssigningDifferentValue.
+  static constexpr bool CheckAssigningDifferentValue(const T& example_value,
+                                                     const T& other_value) {
+    const T const_source(example_value);
+    T copy_assign_target(other_value);
+    copy_assign_target = const_source;
+
+    if (!IsEqual(copy_assign_target, example_value) ||
+        !IsEqual(const_source, example_value)) {
+      return false;
+    }
+    T move_assign_target(other_value);
+    T non_const_source(const_source);
+    move_assign_target = std::move(non_const_source);
+    return IsEqual(move_assign_target, example_value);
+  }
+
+  // Counterpart of RegularTypeChecker::CheckAssigningItsOriginalValue.
+  static constexpr bool CheckAssigningItsOriginalValue(
+      const T& example_value) {
+    T value(example_value);
+    value = example_value;
+
+    if (!IsEqual(value, example_value)) {
+      return false;
+    }
+    T same_value(example_value);
+    value = std::move(same_value);
+    return IsEqual(value, example_value);
+  }
+
+  // Counterpart of RegularTypeChecker::CheckSelfAssignment.
+  static constexpr bool CheckSelfAssignment(const T& example_value,
+                                            const T& other_value) {
+    T value(example_value);
+    const T& const_ref = value;
+    value = const_ref;
+
+    if (!IsEqual(value, example_value)) {
+      return false;
+    }
+    value = std::move(value);
+
+    if (!IsEqual(value, value)) {
+      return false;
+    }
+    value = other_value;
+    return IsEqual(value, other_value);
+  }
+
+  // Counterpart of RegularTypeChecker::CheckCopyValue.
+  static constexpr bool CheckCopyValue(const T& source, const T& other_value) {
+    if (Unequal(source, T())) {
+      T copy_construct_target(source);
+      DoNotUse(copy_construct_target);
+      copy_construct_target = T();
+      DoNotUse(copy_construct_target);
+
+      if (!IsUnequal(source, T())) {
+        return false;
+      }
+      // Note: default-initialization (`T assign_target;`) of a variable of a
+      // trivial type is not allowed in a constexpr function, before C++20.
+      T assign_target{};
+      assign_target = source;
+      DoNotUse(assign_target);
+      assign_target = T();
+      DoNotUse(assign_target);
+
+      if (!IsUnequal(source, T())) {
+        return false;
+      }
+    }
+    T target(source);
+    DoNotUse(target);
+    target = other_value;
+    DoNotUse(target);
+    return IsUnequal(source, other_value);
+  }
+};
+
+// Returns true when the two (different) example values indicate that their
+// type is regular. Can be evaluated at compile-time, for a literal type.
+template <typename T>
+constexpr bool IsRegularConstexpr(const T& example_value1,
+                                  const T& example_value2) {
+  return ConstexprRegularTypeChecker<T>::Check(example_value1, example_value2);
+}
+
+}  // namespace example_implementation_by_niels_dekker
+
+#define STATIC_ASSERT_REGULAR(example_value1, example_value2)               \
+  static_assert(                                                            \
+      ::example_implementation_by_niels_dekker::IsRegularConstexpr(         \
+          example_value1, example_value2),                                  \
+      "Type expected to be regular, with example values: " #example_value1 \
+      ", " #example_value2)
+
+#endif  // GTEST_REGULAR_HAS_CONSTEXPR_CHECKS
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_CONSTEXPR_H_
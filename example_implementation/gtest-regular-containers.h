@@ -0,0 +1,444 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro's
+// EXPECT_REGULAR_IN_CONTAINERS(example_value1, example_value2) and
+// ASSERT_REGULAR_IN_CONTAINERS(example_value1, example_value2), which do the
+// same checks as EXPECT_REGULAR and ASSERT_REGULAR, and then store copies of
+// the examples in an std::vector, an std::deque, an std::map and an
+// std::unordered_map, to see how the type behaves in each of them. Each
+// container is grown, sorted (when it is a sequence), searched and erased
+// from, after which the values of its elements are checked against the
+// examples. For each container and operation, the time per element, and the
+// number of copies, moves, etc., of the elements are recorded as a test
+// property, named "containers.<container>.<operation>".
+//
+// The elements are keyed by an integer, so that the type itself does not need
+// to support `<` or std::hash. The sequences store the elements as pairs of a
+// key and a value, and are sorted by key.
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_CONTAINERS_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_CONTAINERS_H_
+
+#include <algorithm>  // For lower_bound, min, shuffle and sort.
+#include <chrono>     // For steady_clock.
+#include <cstddef>    // For ptrdiff_t and size_t.
+#include <deque>
+#include <map>
+#include <random>     // For mt19937.
+#include <sstream>    // For ostringstream.
+#include <string>
+#include <unordered_map>
+#include <utility>  // For pair.
+#include <vector>
+
+#include "gtest-regular.h"  // For OperationCounter and RegularTypeChecker.
+#include "gtest/gtest.h"    // For Test::RecordProperty and PrintToString.
+#include "gtest/internal/gtest-type-util.h"  // For GetTypeName.
+
+namespace example_implementation_by_niels_dekker {
+
+// Stores copies of two examples of type E in standard containers, and lets a
+// probe measure each operation on the containers. The probe is either a
+// timer, or an operation counter, when E is an OperationCountingWrapper.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename E, typename Probe>
+class ContainerExercise {
+ public:
+  enum { kElementCount = 1000 };
+
+  ContainerExercise(const E& example_value1, const E& example_value2,
+                    Probe& probe, std::string& message)
+      : example1_(example_value1),
+        example2_(example_value2),
+        probe_(probe),
+        message_(message) {
+    for (std::size_t key{}; key < kElementCount; ++key) {
+      shuffled_keys_.push_back(key);
+    }
+    // A fixed seed, so that each run does the same operations.
+    std::shuffle(shuffled_keys_.begin(), shuffled_keys_.end(),
+                 std::mt19937{});
+  }
+
+  bool Run() {
+    return ExerciseSequence<std::vector<Element>>("vector") &&
+           ExerciseSequence<std::deque<Element>>("deque") &&
+           ExerciseMap<std::map<std::size_t, E>>("map") &&
+           ExerciseMap<std::unordered_map<std::size_t, E>>("unordered_map");
+  }
+
+ private:
+  using Element = std::pair<std::size_t, E>;
+
+  static bool IsEqual(const E& left_operand, const E& right_operand) {
+    return RegularTypeThunks<E>::GetOperations().equal(&left_operand,
+                                                        &right_operand);
+  }
+
+  const E& GetExample(const std::size_t key) const {
+    return (key % 2 == 0) ? example1_ : example2_;
+  }
+
+  // Checks the value of the element with the specified key, when it is found.
+  bool CheckElement(const char* const container_name,
+                    const char* const operation_name, const std::size_t key,
+                    const E* const value) const {
+    if (value == nullptr) {
+      message_.append("After ")
+          .append(operation_name)
+          .append(", the std::")
+          .append(container_name)
+          .append(" should still have an element with key ")
+          .append(std::to_string(key))
+          .append("!");
+      return false;
+    }
+    if (IsEqual(*value, GetExample(key))) {
+      return true;
+    }
+    message_.append("After ")
+        .append(operation_name)
+        .append(", an element of the std::")
+        .append(container_name)
+        .append(" should compare equal to the example it was copied from!")
+        .append("\n    Key: ")
+        .append(std::to_string(key))
+        .append("\n    Actual value: ")
+        .append(::testing::PrintToString(*value))
+        .append("\n    Example: ")
+        .append(::testing::PrintToString(GetExample(key)));
+    return false;
+  }
+
+  // Checks that the sequence holds the elements whose keys are from the
+  // specified first key up to kElementCount, sorted by key, when specified.
+  template <typename Sequence>
+  bool CheckSequence(const char* const container_name,
+                     const char* const operation_name,
+                     const Sequence& sequence, const std::size_t first_key,
+                     const bool is_sorted) const {
+    std::vector<const E*> values(kElementCount);
+
+    for (std::size_t i{}; i < sequence.size(); ++i) {
+      const Element& element = sequence[i];
+
+      if (element.first >= first_key && element.first < kElementCount &&
+          (!is_sorted || element.first == first_key + i)) {
+        values[element.first] = &element.second;
+      }
+    }
+    for (std::size_t key{first_key}; key < kElementCount; ++key) {
+      if (!CheckElement(container_name, operation_name, key, values[key])) {
+        return false;
+      }
+    }
+    return CheckSize(container_name, operation_name, sequence.size(),
+                     kElementCount - first_key);
+  }
+
+  bool CheckSize(const char* const container_name,
+                 const char* const operation_name, const std::size_t size,
+                 const std::size_t expected_size) const {
+    if (size == expected_size) {
+      return true;
+    }
+    message_.append("After ")
+        .append(operation_name)
+        .append(", the std::")
+        .append(container_name)
+        .append(" should have ")
+        .append(std::to_string(expected_size))
+        .append(" elements!\n    Actual size: ")
+        .append(std::to_string(size));
+    return false;
+  }
+
+  // Grows the sequence by emplace_back, sorts it by key, looks up each key by
+  // binary search, and erases its first half at once.
+  template <typename Sequence>
+  bool ExerciseSequence(const char* const container_name) {
+    Sequence sequence;
+    probe_.Begin();
+
+    for (const std::size_t key : shuffled_keys_) {
+      sequence.emplace_back(key, GetExample(key));
+    }
+    probe_.End(container_name, "grow", kElementCount);
+
+    if (!CheckSequence(container_name, "grow", sequence, 0, false)) {
+      return false;
+    }
+    probe_.Begin();
+    std::sort(sequence.begin(), sequence.end(),
+              [](const Element& left_element, const Element& right_element) {
+                return left_element.first < right_element.first;
+              });
+    probe_.End(container_name, "sort", kElementCount);
+
+    if (!CheckSequence(container_name, "sort", sequence, 0, true)) {
+      return false;
+    }
+    std::vector<const E*> found_values(kElementCount);
+    probe_.Begin();
+
+    for (const std::size_t key : shuffled_keys_) {
+      const auto found = std::lower_bound(
+          sequence.begin(), sequence.end(), key,
+          [](const Element& element, const std::size_t value) {
+            return element.first < value;
+          });
+      found_values[key] = (found == sequence.end() || found->first != key)
+                              ? nullptr
+                              : &found->second;
+    }
+    probe_.End(container_name, "lookup", kElementCount);
+
+    for (std::size_t key{}; key < kElementCount; ++key) {
+      if (!CheckElement(container_name, "lookup", key, found_values[key])) {
+        return false;
+      }
+    }
+    constexpr std::size_t first_remaining_key{kElementCount / 2};
+    probe_.Begin();
+    sequence.erase(sequence.begin(),
+                   sequence.begin() +
+                       static_cast<std::ptrdiff_t>(first_remaining_key));
+    probe_.End(container_name, "erase", first_remaining_key);
+
+    return CheckSequence(container_name, "erase", sequence,
+                         first_remaining_key, true);
+  }
+
+  // Grows the map by emplace, looks up each key by find, and erases half of
+  // the elements, one by one.
+  template <typename Map>
+  bool ExerciseMap(const char* const container_name) {
+    Map map;
+    probe_.Begin();
+
+    for (const std::size_t key : shuffled_keys_) {
+      map.emplace(key, GetExample(key));
+    }
+    probe_.End(container_name, "grow", kElementCount);
+
+    std::vector<const E*> found_values(kElementCount);
+    probe_.Begin();
+
+    for (const std::size_t key : shuffled_keys_) {
+      const auto found = map.find(key);
+      found_values[key] = (found == map.end()) ? nullptr : &found->second;
+    }
+    probe_.End(container_name, "lookup", kElementCount);
+
+    for (std::size_t key{}; key < kElementCount; ++key) {
+      if (!CheckElement(container_name, "lookup", key, found_values[key])) {
+        return false;
+      }
+    }
+    constexpr std::size_t first_remaining_key{kElementCount / 2};
+    probe_.Begin();
+
+    for (const std::size_t key : shuffled_keys_) {
+      if (key < first_remaining_key) {
+        map.erase(key);
+      }
+    }
+    probe_.End(container_name, "erase", first_remaining_key);
+
+    for (std::size_t key{first_remaining_key}; key < kElementCount; ++key) {
+      const auto found = map.find(key);
+
+      if (!CheckElement(container_name, "erase", key,
+                        (found == map.end()) ? nullptr : &found->second)) {
+        return false;
+      }
+    }
+    return CheckSize(container_name, "erase", map.size(),
+                     kElementCount - first_remaining_key);
+  }
+
+  const E example1_;
+  const E example2_;
+  std::vector<std::size_t> shuffled_keys_;
+  Probe& probe_;
+  std::string& message_;
+};
+
+// Measures the time per element of each operation, taking the shortest time
+// of a number of runs.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+class ContainerTimingProbe {
+ public:
+  void Begin() { start_time_ = Clock::now(); }
+
+  void End(const char* const container_name, const char* const operation_name,
+           const std::size_t element_count) {
+    const double nanoseconds_per_element =
+        std::chrono::duration<double, std::nano>(Clock::now() - start_time_)
+            .count() /
+        static_cast<double>(element_count);
+    const std::string key =
+        std::string(container_name) + '.' + operation_name;
+
+    for (auto& key_and_duration : durations_) {
+      if (key_and_duration.first == key) {
+        key_and_duration.second =
+            std::min(key_and_duration.second, nanoseconds_per_element);
+        return;
+      }
+    }
+    durations_.emplace_back(key, nanoseconds_per_element);
+  }
+
+  // The measured operations ("<container>.<operation>"), in the order in which
+  // they were first measured, with their nanoseconds per element.
+  const std::vector<std::pair<std::string, double>>& GetDurations() const {
+    return durations_;
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start_time_;
+  std::vector<std::pair<std::string, double>> durations_;
+};
+
+// Counts the operations on the elements (of type OperationCountingWrapper) by
+// each operation on a container.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+class ContainerCountingProbe {
+ public:
+  void Begin() { counter_ = OperationCounter(); }
+
+  void End(const char* const container_name, const char* const operation_name,
+           std::size_t /*element_count*/) {
+    counts_.emplace_back(std::string(container_name) + '.' + operation_name,
+                         counter_.GetCount());
+  }
+
+  // The counted operations ("<container>.<operation>"), in the order in which
+  // they were done, with their counts.
+  const std::vector<std::pair<std::string, OperationCount>>& GetCounts()
+      const {
+    return counts_;
+  }
+
+ private:
+  OperationCounter counter_;
+  std::vector<std::pair<std::string, OperationCount>> counts_;
+};
+
+// Runs the container exercise a few times on copies of the examples, to
+// measure the time per element, and once on wrapped copies, to count the
+// operations on the elements, and records the results as test properties.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T>
+bool ExerciseContainers(const T& example_value1, const T& example_value2,
+                        std::string& message) {
+  constexpr int run_count{5};
+  ContainerTimingProbe timing_probe;
+
+  for (int run{}; run < run_count; ++run) {
+    ContainerExercise<T, ContainerTimingProbe> exercise(
+        example_value1, example_value2, timing_probe, message);
+
+    if (!exercise.Run()) {
+      return false;
+    }
+  }
+
+  using Wrapper = OperationCountingWrapper<T>;
+  ContainerCountingProbe counting_probe;
+  ContainerExercise<Wrapper, ContainerCountingProbe> exercise(
+      Wrapper(example_value1), Wrapper(example_value2), counting_probe,
+      message);
+
+  if (!exercise.Run()) {
+    return false;
+  }
+  const auto& durations = timing_probe.GetDurations();
+  const auto& counts = counting_probe.GetCounts();
+
+  for (std::size_t i{}; i < durations.size() && i < counts.size(); ++i) {
+    std::ostringstream stream;
+    stream.precision(1);
+    stream << std::fixed << durations[i].second << " ns per element, "
+           << counts[i].second.ToString();
+    ::testing::Test::RecordProperty("containers." + durations[i].first,
+                                    stream.str());
+  }
+  return true;
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeInContainers(const char* const file, const int line,
+                                  const T& example_value1,
+                                  const char* const example_expression1,
+                                  const T& example_value2,
+                                  const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &example_value1, example_expression1,
+                                   &example_value2, example_expression2,
+                                   message);
+  const std::string type_name = testing::internal::GetTypeName<T>();
+
+  if (!checker.Check()) {
+    ReportIrregularType(is_failure_fatal, file, line, type_name, message);
+    return;
+  }
+  if (!ExerciseContainers(example_value1, example_value2, message)) {
+    ReportFailure(is_failure_fatal, file, line,
+                  "Type expected to be regular in containers: '" + type_name +
+                      "'\n  Examples: " + example_expression1 + " and " +
+                      example_expression2 + "\n  " + message);
+  }
+}
+
+}  // namespace example_implementation_by_niels_dekker
+
+#define EXPECT_REGULAR_IN_CONTAINERS(example_value1, example_value2)     \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeInContainers<false>(                               \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+#define ASSERT_REGULAR_IN_CONTAINERS(example_value1, example_value2)     \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeInContainers<true>(                                \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_CONTAINERS_H_
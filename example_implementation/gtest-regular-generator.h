@@ -0,0 +1,293 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro's
+// EXPECT_REGULAR_GENERATED(generator) and ASSERT_REGULAR_GENERATED(generator),
+// which check that a type is regular, for a large number of pairs of example
+// values, produced by the specified generator. The generator is called as
+// generator(engine, size), where engine is an std::mt19937_64, seeded for each
+// pair, and size a hint of the "size" of the value to be produced. When a pair
+// fails the check, the check is repeated with smaller sizes (but the same seed)
+// to find a minimal pair that reproduces the failure. The failure message
+// includes the seed, to allow reproducing the failure.
+//
+// The variants EXPECT_REGULAR_GENERATED_WITH_OPTIONS(generator, options) and
+// ASSERT_REGULAR_GENERATED_WITH_OPTIONS(generator, options) allow specifying
+// the number of iterations, the maximum size, and the seed.
+//
+// FindSmallBufferThreshold(generator, max_size) finds the smallest size for
+// which the copy of a generated value allocates memory. For example, the size
+// at which an std::string leaves its small buffer.
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_GENERATOR_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_GENERATOR_H_
+
+#include <cstddef>  // For size_t.
+#include <cstdint>  // For uint64_t.
+#include <limits>   // For numeric_limits.
+#include <random>   // For mt19937_64.
+#include <string>
+#include <type_traits>  // For decay.
+#include <utility>      // For declval.
+
+#include "gtest-regular.h"  // For AllocationCounter and RegularTypeChecker.
+#include "gtest/gtest.h"    // For GTEST_FLAG_GET and Test::RecordProperty.
+#include "gtest/internal/gtest-type-util.h"  // For GetTypeName.
+
+namespace example_implementation_by_niels_dekker {
+
+struct GeneratorOptions {
+  // The number of pairs of example values to be generated.
+  std::size_t iteration_count = 1000;
+
+  // The size hints passed to the generator cycle from zero to max_size.
+  std::size_t max_size = 100;
+
+  // The seed of the first pair. Zero means: use the seed specified by
+  // --gtest_random_seed, or otherwise the fixed default seed, 1, so that
+  // repeated runs generate the same pairs.
+  std::uint64_t seed = 0;
+};
+
+// Checks that a type is regular, for the pairs of example values produced by a
+// generator. Uses a single RegularTypeChecker, and a single message string, for
+// all pairs, so that a successful iteration does not allocate memory (unless
+// the generator, or the type itself, does so).
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T, typename Generator>
+class GeneratedExamplesChecker {
+ public:
+  GeneratedExamplesChecker(Generator& generator,
+                           const GeneratorOptions& options,
+                           std::string& message)
+      : generator_(generator),
+        options_(options),
+        seed_(SelectSeed(options)),
+        message_(message),
+        checker_(RegularTypeThunks<T>::GetOperations(), &value1_,
+                 "first generated value", &value2_, "second generated value",
+                 message) {}
+
+  std::uint64_t GetSeed() const { return seed_; }
+
+  std::size_t GetCheckedPairCount() const { return checked_pair_count_; }
+
+  bool Check() {
+    // Checks the options before using them, as a max_size of SIZE_MAX would
+    // make the computation of the sizes (modulo max_size + 1) overflow.
+    if (options_.iteration_count == 0 ||
+        options_.max_size == std::numeric_limits<std::size_t>::max()) {
+      message_.append(
+          "GeneratorOptions should specify an iteration_count greater than "
+          "zero, and a max_size less than SIZE_MAX!");
+      return false;
+    }
+    for (std::size_t iteration{}; iteration < options_.iteration_count;
+         ++iteration) {
+      const std::size_t size = iteration % (options_.max_size + 1);
+      std::size_t other_size{};
+
+      if (Generate(iteration, size, other_size)) {
+        ++checked_pair_count_;
+
+        if (!checker_.Check()) {
+          Shrink(iteration, size, other_size);
+          return false;
+        }
+      }
+    }
+    if (checked_pair_count_ == 0) {
+      message_.append(
+          "The generator should produce different values!\n    Seed: ");
+      message_.append(std::to_string(seed_));
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  // Returns the seed specified by the options, or by --gtest_random_seed, or
+  // otherwise the fixed default seed.
+  static std::uint64_t SelectSeed(const GeneratorOptions& options) {
+    if (options.seed != 0) {
+      return options.seed;
+    }
+    const auto flag_seed = GTEST_FLAG_GET(random_seed);
+    return flag_seed > 0 ? static_cast<std::uint64_t>(flag_seed) : 1;
+  }
+
+  // Lets the generator produce a pair of values, for the specified iteration.
+  // Returns false when the values are equal, as such a pair cannot be checked.
+  bool Generate(const std::size_t iteration, const std::size_t size,
+                std::size_t& other_size) {
+    std::mt19937_64 engine(seed_ + iteration);
+    value1_ = generator_(engine, size);
+    other_size = static_cast<std::size_t>(engine() % (size + 1));
+    value2_ = generator_(engine, other_size);
+
+    if (!RegularTypeThunks<T>::GetOperations().unequal(&value1_, &value2_)) {
+      return false;
+    }
+    checker_.UpdateExampleDigests();
+    message_.clear();
+    return true;
+  }
+
+  // Repeats the failing iteration with smaller sizes, to find the smallest
+  // size that still reproduces the failure, and adds the sizes and the seed to
+  // the message.
+  void Shrink(const std::size_t iteration, const std::size_t size,
+              const std::size_t other_size) {
+    std::string failure_message = message_;
+    std::size_t minimal_size = size;
+    std::size_t minimal_other_size = other_size;
+
+    for (std::size_t smaller_size{}; smaller_size < size; ++smaller_size) {
+      std::size_t smaller_other_size{};
+
+      if (Generate(iteration, smaller_size, smaller_other_size) &&
+          !checker_.Check()) {
+        failure_message = message_;
+        minimal_size = smaller_size;
+        minimal_other_size = smaller_other_size;
+        break;
+      }
+    }
+    message_.assign("A generated pair of values failed the check!\n    Seed: ")
+        .append(std::to_string(seed_))
+        .append("\n    Iteration: ")
+        .append(std::to_string(iteration))
+        .append("\n    Sizes: ")
+        .append(std::to_string(minimal_size))
+        .append(" and ")
+        .append(std::to_string(minimal_other_size));
+
+    if (minimal_size < size) {
+      message_.append(" (shrunk from ")
+          .append(std::to_string(size))
+          .append(" and ")
+          .append(std::to_string(other_size))
+          .append(")");
+    }
+    message_.append("\n  ").append(failure_message);
+  }
+
+  Generator& generator_;
+  const GeneratorOptions options_;
+  const std::uint64_t seed_;
+  std::string& message_;
+  T value1_{};
+  T value2_{};
+  RegularTypeChecker checker_;
+  std::size_t checked_pair_count_{};
+};
+
+// Returns the smallest size (up to max_size) for which the copy-construction of
+// a value produced by the generator allocates memory, or max_size + 1 when none
+// of them does. Records the result as the test property
+// "memory.small_buffer_threshold". Requires linking gtest-regular-new-delete.cc
+// into the test program.
+template <typename Generator>
+std::size_t FindSmallBufferThreshold(Generator&& generator,
+                                     const std::size_t max_size = 1000) {
+  if (!AllocationCounter::IsInstalled()) {
+    ADD_FAILURE() << "Allocation counting requires linking "
+                     "gtest-regular-new-delete.cc into the test program!";
+    return 0;
+  }
+  std::size_t size{};
+
+  for (; size <= max_size; ++size) {
+    std::mt19937_64 engine(size);
+    const auto value = generator(engine, size);
+    const AllocationCounter counter;
+    const decltype(value) copy(value);
+    static_cast<void>(copy);
+
+    if (counter.GetCount().allocations > 0) {
+      break;
+    }
+  }
+  ::testing::Test::RecordProperty(
+      "memory.small_buffer_threshold",
+      size <= max_size ? std::to_string(size) : "none");
+  return size;
+}
+
+template <bool is_failure_fatal, typename Generator>
+void CheckRegularTypeGenerated(const char* const file, const int line,
+                               Generator&& generator,
+                               const char* const generator_expression,
+                               const GeneratorOptions& options) {
+  using T = typename std::decay<decltype(generator(
+      std::declval<std::mt19937_64&>(), std::size_t{}))>::type;
+
+  std::string message;
+  GeneratedExamplesChecker<T, typename std::remove_reference<Generator>::type>
+      checker(generator, options, message);
+  const bool is_success = checker.Check();
+
+  ::testing::Test::RecordProperty("generator.seed",
+                                  std::to_string(checker.GetSeed()));
+  ::testing::Test::RecordProperty(
+      "generator.checked_pairs", std::to_string(checker.GetCheckedPairCount()));
+
+  if (!is_success) {
+    ReportFailure(is_failure_fatal, file, line,
+                  "Type expected to be regular: '" +
+                      testing::internal::GetTypeName<T>() +
+                      "'\n  Generator: " + generator_expression + "\n  " +
+                      message);
+  }
+}
+
+}  // namespace example_implementation_by_niels_dekker
+
+#define EXPECT_REGULAR_GENERATED(generator)                                  \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeGenerated<false>( \
+      __FILE__, __LINE__, generator, #generator,                              \
+      ::example_implementation_by_niels_dekker::GeneratorOptions{})
+
+#define ASSERT_REGULAR_GENERATED(generator)                                 \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeGenerated<true>( \
+      __FILE__, __LINE__, generator, #generator,                             \
+      ::example_implementation_by_niels_dekker::GeneratorOptions{})
+
+#define EXPECT_REGULAR_GENERATED_WITH_OPTIONS(generator, options)             \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeGenerated<false>( \
+      __FILE__, __LINE__, generator, #generator, options)
+
+#define ASSERT_REGULAR_GENERATED_WITH_OPTIONS(generator, options)            \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeGenerated<true>( \
+      __FILE__, __LINE__, generator, #generator, options)
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_GENERATOR_H_
@@ -0,0 +1,390 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro's EXPECT_REGULAR_HASHABLE(example_value1,
+// example_value2) and ASSERT_REGULAR_HASHABLE(example_value1, example_value2),
+// which check that a type is regular, and that std::hash is consistent with
+// its operator==, as well as EXPECT_HASH_QUALITY(values) and
+// ASSERT_HASH_QUALITY(values), which check how well std::hash spreads a set of
+// values over the buckets of a hash table.
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_HASH_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_HASH_H_
+
+#include <algorithm>   // For max and sort.
+#include <cstddef>     // For size_t.
+#include <functional>  // For hash.
+#include <iterator>    // For begin.
+#include <sstream>     // For ostringstream.
+#include <string>
+#include <type_traits>  // For decay.
+#include <utility>      // For move.
+#include <vector>
+
+#include "gtest-regular.h"  // For RegularTypeChecker and ReportFailure.
+#include "gtest/gtest.h"    // For Test::RecordProperty.
+#include "gtest/internal/gtest-type-util.h"  // For GetTypeName.
+
+namespace example_implementation_by_niels_dekker {
+
+// Thresholds of the hash quality check. The values are distributed over a
+// hash table of at least as many buckets as values (a maximum load factor of
+// 1, the default of std::unordered_map), by `hash_value % bucket_count`,
+// where bucket_count is a prime number.
+struct HashQualityThresholds {
+  // The maximum fraction of the values whose hash value is equal to the hash
+  // value of another value.
+  double max_collision_ratio = 0.01;
+
+  // The maximum mean number of elements visited by a successful lookup. For a
+  // hash function that distributes the values uniformly at random, it is
+  // close to 1.5.
+  double max_mean_probe_length = 2.0;
+};
+
+// Statistics of the distribution of a set of hash values over the buckets of a
+// hash table.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+struct HashStatistics {
+  std::size_t value_count;
+  std::size_t distinct_hash_value_count;
+  std::size_t bucket_count;
+  std::size_t occupied_bucket_count;
+  std::size_t max_bucket_size;
+  double collision_ratio;
+  double mean_probe_length;
+
+  static HashStatistics Compute(std::vector<std::size_t> hash_values) {
+    HashStatistics statistics{};
+    const std::size_t value_count = hash_values.size();
+    statistics.value_count = value_count;
+    statistics.bucket_count = GetSmallestPrimeNotLessThan(value_count);
+
+    std::vector<std::size_t> bucket_sizes(statistics.bucket_count);
+
+    for (const std::size_t hash_value : hash_values) {
+      ++bucket_sizes[hash_value % statistics.bucket_count];
+    }
+
+    std::size_t probe_count{};
+
+    for (const std::size_t bucket_size : bucket_sizes) {
+      if (bucket_size > 0) {
+        ++statistics.occupied_bucket_count;
+        statistics.max_bucket_size =
+            std::max(statistics.max_bucket_size, bucket_size);
+        // Finding the i-th element of a bucket visits i elements.
+        probe_count += bucket_size * (bucket_size + 1) / 2;
+      }
+    }
+
+    std::sort(hash_values.begin(), hash_values.end());
+
+    for (std::size_t i{}; i < value_count; ++i) {
+      if (i == 0 || hash_values[i] != hash_values[i - 1]) {
+        ++statistics.distinct_hash_value_count;
+      }
+    }
+
+    if (value_count > 0) {
+      statistics.collision_ratio =
+          static_cast<double>(value_count -
+                              statistics.distinct_hash_value_count) /
+          static_cast<double>(value_count);
+      statistics.mean_probe_length = static_cast<double>(probe_count) /
+                                     static_cast<double>(value_count);
+    }
+    return statistics;
+  }
+
+ private:
+  static std::size_t GetSmallestPrimeNotLessThan(const std::size_t number) {
+    for (std::size_t candidate = std::max(number, std::size_t{2});;
+         ++candidate) {
+      bool is_prime{true};
+
+      for (std::size_t divisor{2}; divisor * divisor <= candidate; ++divisor) {
+        if (candidate % divisor == 0) {
+          is_prime = false;
+          break;
+        }
+      }
+      if (is_prime) {
+        return candidate;
+      }
+    }
+  }
+};
+
+// Checks that equal objects have equal std::hash values: copies,
+// move-constructed, copy-assigned and move-assigned objects should have the
+// same hash value as the original. Reuses the examples of a
+// RegularTypeChecker.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T>
+class HashConsistencyChecker {
+ public:
+  HashConsistencyChecker(const std::vector<RegularTypeExample>& examples,
+                         std::string& message)
+      : examples_(examples), message_(message) {}
+
+  bool Check() const {
+    if (Hash(T()) != Hash(T())) {
+      message_.append(
+          "Value-initialized objects should have the same hash value!");
+      return false;
+    }
+    for (std::size_t i{}; i < examples_.size(); ++i) {
+      if (!CheckExample(i, (i + 1) % examples_.size())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  bool CheckExample(const std::size_t example_index,
+                    const std::size_t other_index) const {
+    const RegularTypeExample& example = examples_[example_index];
+    const T& value = GetValue(example_index);
+    const std::size_t hash_value = Hash(value);
+
+    if (!CheckHashValue(example, hash_value, Hash(value),
+                        "Hashing the same object twice should yield the same "
+                        "hash value!")) {
+      return false;
+    }
+
+    const T copy(value);
+
+    if (!CheckHashValue(example, hash_value, Hash(copy),
+                        "A copy-constructed object should have the same hash "
+                        "value as the original!")) {
+      return false;
+    }
+
+    T source(value);
+    const T move_constructed(std::move(source));
+
+    if (!CheckHashValue(example, hash_value, Hash(move_constructed),
+                        "A move-constructed object should have the same hash "
+                        "value as the original!")) {
+      return false;
+    }
+
+    T copy_assigned(GetValue(other_index));
+    copy_assigned = value;
+
+    if (!CheckHashValue(example, hash_value, Hash(copy_assigned),
+                        "A copy-assigned-to object should have the same hash "
+                        "value as the source object!")) {
+      return false;
+    }
+
+    T move_assigned(GetValue(other_index));
+    move_assigned = T(value);
+
+    return CheckHashValue(example, hash_value, Hash(move_assigned),
+                          "A move-assigned-to object should have the same "
+                          "hash value as the source object!");
+  }
+
+  static std::size_t Hash(const T& value) { return std::hash<T>{}(value); }
+
+  bool CheckHashValue(const RegularTypeExample& example,
+                      const std::size_t expected_hash_value,
+                      const std::size_t actual_hash_value,
+                      const char* const short_message) const {
+    if (actual_hash_value == expected_hash_value) {
+      return true;
+    }
+    message_.append(short_message)
+        .append("\n    Expected hash value: ")
+        .append(std::to_string(expected_hash_value))
+        .append("\n    Actual hash value: ")
+        .append(std::to_string(actual_hash_value))
+        .append("\n    Example: ")
+        .append(example.ToString());
+    return false;
+  }
+
+  const T& GetValue(const std::size_t example_index) const {
+    return *static_cast<const T*>(examples_[example_index].GetValue());
+  }
+
+  const std::vector<RegularTypeExample>& examples_;
+  std::string& message_;
+};
+
+// Records the statistics as properties of the current test.
+inline void RecordHashStatistics(const HashStatistics& statistics) {
+  const auto to_string = [](const double value) {
+    std::ostringstream stream;
+    stream.precision(3);
+    stream << std::fixed << value;
+    return stream.str();
+  };
+  using ::testing::Test;
+  Test::RecordProperty("hash.values", std::to_string(statistics.value_count));
+  Test::RecordProperty("hash.distinct_hash_values",
+                       std::to_string(statistics.distinct_hash_value_count));
+  Test::RecordProperty("hash.bucket_count",
+                       std::to_string(statistics.bucket_count));
+  Test::RecordProperty("hash.occupied_buckets",
+                       std::to_string(statistics.occupied_bucket_count));
+  Test::RecordProperty("hash.max_bucket_size",
+                       std::to_string(statistics.max_bucket_size));
+  Test::RecordProperty("hash.collision_ratio",
+                       to_string(statistics.collision_ratio));
+  Test::RecordProperty("hash.mean_probe_length",
+                       to_string(statistics.mean_probe_length));
+}
+
+// Checks the statistics against the thresholds. Returns false, and appends the
+// reason to the message, when a threshold is exceeded.
+inline bool CheckHashStatistics(const HashStatistics& statistics,
+                                const HashQualityThresholds& thresholds,
+                                std::string& message) {
+  if (statistics.value_count < 2) {
+    message.append("At least two different values are required!");
+    return false;
+  }
+  const bool has_too_many_collisions =
+      statistics.collision_ratio > thresholds.max_collision_ratio;
+
+  if (has_too_many_collisions ||
+      statistics.mean_probe_length > thresholds.max_mean_probe_length) {
+    std::ostringstream stream;
+    stream.precision(3);
+    stream << std::fixed
+           << (has_too_many_collisions
+                   ? "Too many values have the same hash value!"
+                   : "The hash values are not spread well over the buckets!")
+           << "\n    Values: " << statistics.value_count
+           << "\n    Distinct hash values: "
+           << statistics.distinct_hash_value_count
+           << "\n    Collision ratio: " << statistics.collision_ratio
+           << " (threshold: " << thresholds.max_collision_ratio << ')'
+           << "\n    Buckets: " << statistics.bucket_count
+           << " (occupied: " << statistics.occupied_bucket_count
+           << ", largest: " << statistics.max_bucket_size << ')'
+           << "\n    Mean probe length: " << statistics.mean_probe_length
+           << " (threshold: " << thresholds.max_mean_probe_length << ')';
+    message.append(stream.str());
+    return false;
+  }
+  return true;
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularHashableType(const char* const file, const int line,
+                              const T& example_value1,
+                              const char* const example_expression1,
+                              const T& example_value2,
+                              const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &example_value1, example_expression1,
+                                   &example_value2, example_expression2,
+                                   message);
+  const HashConsistencyChecker<T> hash_checker(checker.GetExamples(),
+                                               message);
+
+  if (!(checker.Check() && hash_checker.Check())) {
+    ReportFailure(is_failure_fatal, file, line,
+                  "Type expected to be regular and hashable: '" +
+                      testing::internal::GetTypeName<T>() + "'\n  " + message);
+  }
+}
+
+// Checks the distribution of the hash values of the elements of a range. The
+// elements are assumed to be different from each other.
+template <bool is_failure_fatal, typename Range>
+void CheckHashQuality(
+    const char* const file, const int line, const Range& values,
+    const char* const values_expression,
+    const HashQualityThresholds& thresholds = HashQualityThresholds()) {
+  using T = typename std::decay<decltype(*std::begin(values))>::type;
+
+  std::vector<std::size_t> hash_values;
+
+  for (const T& value : values) {
+    hash_values.push_back(std::hash<T>{}(value));
+  }
+
+  const HashStatistics statistics =
+      HashStatistics::Compute(std::move(hash_values));
+  RecordHashStatistics(statistics);
+
+  std::string message;
+
+  if (!CheckHashStatistics(statistics, thresholds, message)) {
+    ReportFailure(is_failure_fatal, file, line,
+                  "Type expected to have a hash function that spreads its "
+                  "values well: '" +
+                      testing::internal::GetTypeName<T>() +
+                      "'\n  Range: " + values_expression + "\n  " + message);
+  }
+}
+
+}  // namespace example_implementation_by_niels_dekker
+
+#define EXPECT_REGULAR_HASHABLE(example_value1, example_value2)             \
+  ::example_implementation_by_niels_dekker::CheckRegularHashableType<false>( \
+      __FILE__, __LINE__, example_value1, #example_value1, example_value2,  \
+      #example_value2)
+
+#define ASSERT_REGULAR_HASHABLE(example_value1, example_value2)             \
+  ::example_implementation_by_niels_dekker::CheckRegularHashableType<true>(  \
+      __FILE__, __LINE__, example_value1, #example_value1, example_value2,  \
+      #example_value2)
+
+#define EXPECT_HASH_QUALITY(values)                                     \
+  ::example_implementation_by_niels_dekker::CheckHashQuality<false>(    \
+      __FILE__, __LINE__, values, #values)
+
+#define ASSERT_HASH_QUALITY(values)                                     \
+  ::example_implementation_by_niels_dekker::CheckHashQuality<true>(     \
+      __FILE__, __LINE__, values, #values)
+
+// Variants of EXPECT_HASH_QUALITY and ASSERT_HASH_QUALITY that allow
+// specifying the thresholds by HashQualityThresholds.
+#define EXPECT_HASH_QUALITY_WITH_THRESHOLDS(values, thresholds)         \
+  ::example_implementation_by_niels_dekker::CheckHashQuality<false>(    \
+      __FILE__, __LINE__, values, #values, thresholds)
+
+#define ASSERT_HASH_QUALITY_WITH_THRESHOLDS(values, thresholds)         \
+  ::example_implementation_by_niels_dekker::CheckHashQuality<true>(     \
+      __FILE__, __LINE__, values, #values, thresholds)
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_HASH_H_
@@ -0,0 +1,225 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro's of gtest-regular.h, like
+// EXPECT_REGULAR(example_value1, example_value2) and
+// ASSERT_REGULAR(example_value1, example_value2). It is included by
+// gtest-regular.h. A test that imports the C++20 module gtest_regular, instead
+// of including gtest-regular.h, should include this header file directly, as a
+// module does not export macro's:
+//
+//   import gtest_regular;
+//   #include "gtest-regular-macros.h"
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_MACROS_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_MACROS_H_
+
+#define EXPECT_REGULAR(example_value1, example_value2)                     \
+  ::example_implementation_by_niels_dekker::CheckRegularType<false>(       \
+      __FILE__, __LINE__, example_value1, #example_value1, example_value2, \
+      #example_value2)
+
+#define ASSERT_REGULAR(example_value1, example_value2)                     \
+  ::example_implementation_by_niels_dekker::CheckRegularType<true>(        \
+      __FILE__, __LINE__, example_value1, #example_value1, example_value2, \
+      #example_value2)
+
+// EXPECT_REGULAR_NOALLOC(example_value1, example_value2) and
+// ASSERT_REGULAR_NOALLOC(example_value1, example_value2) do the same checks as
+// EXPECT_REGULAR and ASSERT_REGULAR, and moreover check that move-construction,
+// move-assignment, value-initialization and swap do not allocate memory. They
+// require gtest-regular-new-delete.cc to be linked into the test program.
+#define EXPECT_REGULAR_NOALLOC(example_value1, example_value2)               \
+  ::example_implementation_by_niels_dekker::                                 \
+      CheckRegularTypeWithoutAllocation<false>(                              \
+          __FILE__, __LINE__, example_value1, #example_value1, example_value2, \
+          #example_value2)
+
+#define ASSERT_REGULAR_NOALLOC(example_value1, example_value2)               \
+  ::example_implementation_by_niels_dekker::                                 \
+      CheckRegularTypeWithoutAllocation<true>(                               \
+          __FILE__, __LINE__, example_value1, #example_value1, example_value2, \
+          #example_value2)
+
+// EXPECT_REGULAR_NOTHROW_MOVE(example_value1, example_value2) and
+// ASSERT_REGULAR_NOTHROW_MOVE(example_value1, example_value2) do the same
+// checks as EXPECT_REGULAR and ASSERT_REGULAR, and moreover check that
+// move-construction, move-assignment and swap are noexcept, and that growing
+// an std::vector of examples does not copy them. They also record whether
+// those operations are noexcept, as a test property named "noexcept.<type
+// name>".
+#define EXPECT_REGULAR_NOTHROW_MOVE(example_value1, example_value2)           \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeWithNothrowMove< \
+      false>(__FILE__, __LINE__, example_value1, #example_value1,            \
+             example_value2, #example_value2)
+
+#define ASSERT_REGULAR_NOTHROW_MOVE(example_value1, example_value2)           \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeWithNothrowMove< \
+      true>(__FILE__, __LINE__, example_value1, #example_value1,             \
+            example_value2, #example_value2)
+
+// EXPECT_REGULAR_PARALLEL(example_value1, example_value2) and
+// ASSERT_REGULAR_PARALLEL(example_value1, example_value2) do the same checks as
+// EXPECT_REGULAR and ASSERT_REGULAR, but run them on as many threads as the
+// hardware supports. Meant for types whose copies and comparisons are
+// expensive. Each check works on its own copies of the examples.
+#define EXPECT_REGULAR_PARALLEL(example_value1, example_value2)            \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeInParallel<   \
+      false>(__FILE__, __LINE__, example_value1, #example_value1,         \
+             example_value2, #example_value2)
+
+#define ASSERT_REGULAR_PARALLEL(example_value1, example_value2)            \
+  ::example_implementation_by_niels_dekker::CheckRegularTypeInParallel<   \
+      true>(__FILE__, __LINE__, example_value1, #example_value1,          \
+            example_value2, #example_value2)
+
+// EXPECT_REGULAR_COUNTED(example_value1, example_value2) and
+// ASSERT_REGULAR_COUNTED(example_value1, example_value2) do the same checks as
+// EXPECT_REGULAR and ASSERT_REGULAR, on copies of the examples wrapped by
+// OperationCountingWrapper. They record how many copies, moves, comparisons,
+// etc. each check does, as test properties named "operations.<check name>".
+#define EXPECT_REGULAR_COUNTED(example_value1, example_value2)           \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeCountingOperations<false>(                         \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+#define ASSERT_REGULAR_COUNTED(example_value1, example_value2)           \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeCountingOperations<true>(                          \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+// EXPECT_REGULAR_NO_LEAK(example_value1, example_value2) and
+// ASSERT_REGULAR_NO_LEAK(example_value1, example_value2) do the same checks as
+// EXPECT_REGULAR and ASSERT_REGULAR, and check that each of the checks frees
+// all the memory that it allocates. The failure message names the leaking
+// check. Require linking gtest-regular-new-delete.cc into the test program.
+#define EXPECT_REGULAR_NO_LEAK(example_value1, example_value2)           \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeWithoutLeaks<false>(                               \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+#define ASSERT_REGULAR_NO_LEAK(example_value1, example_value2)           \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeWithoutLeaks<true>(                                \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+// EXPECT_REGULAR_SWAPPABLE(example_value1, example_value2) and
+// ASSERT_REGULAR_SWAPPABLE(example_value1, example_value2) do the same checks
+// as EXPECT_REGULAR and ASSERT_REGULAR, and check the swap of the type (a
+// custom swap found by argument-dependent lookup, or otherwise std::swap): it
+// should exchange the values, also with a moved-from object or with itself, be
+// noexcept, and not allocate memory. The durations of the custom swap (if any)
+// and the generic swap by three moves, and their ratio, are recorded as a test
+// property named "swap.<type name>", but they do not affect the verdict.
+// Require linking gtest-regular-new-delete.cc into the test program.
+#define EXPECT_REGULAR_SWAPPABLE(example_value1, example_value2)         \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeSwappable<false>(                                  \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+#define ASSERT_REGULAR_SWAPPABLE(example_value1, example_value2)         \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeSwappable<true>(                                   \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+// EXPECT_REGULAR_FAST_SWAP(example_value1, example_value2) and
+// ASSERT_REGULAR_FAST_SWAP(example_value1, example_value2) do the same checks
+// as EXPECT_REGULAR_SWAPPABLE and ASSERT_REGULAR_SWAPPABLE, and moreover check
+// that a custom swap is not much slower than the generic swap. As this verdict
+// depends on time measurements, it may be affected by the load of the machine.
+#define EXPECT_REGULAR_FAST_SWAP(example_value1, example_value2)         \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeWithFastSwap<false>(                               \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+#define ASSERT_REGULAR_FAST_SWAP(example_value1, example_value2)         \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeWithFastSwap<true>(                                \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+// EXPECT_TRIVIALLY_RELOCATABLE(example_value1, example_value2) and
+// ASSERT_TRIVIALLY_RELOCATABLE(example_value1, example_value2) do the same
+// checks as EXPECT_REGULAR and ASSERT_REGULAR, and check empirically that the
+// type may be relocated by memcpy, as a container might do when it grows: each
+// example is relocated bitwise into other storage, after which the original
+// storage is overwritten. The result is recorded as a test property named
+// "trivially_relocatable.<type name>". Note that a type that passes may still
+// not be trivially relocatable for values other than the examples.
+#define EXPECT_TRIVIALLY_RELOCATABLE(example_value1, example_value2)     \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckTriviallyRelocatableType<false>(                              \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+#define ASSERT_TRIVIALLY_RELOCATABLE(example_value1, example_value2)     \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckTriviallyRelocatableType<true>(                               \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+// EXPECT_REGULAR_MEMORY_PROFILE(example_value1, example_value2) and
+// ASSERT_REGULAR_MEMORY_PROFILE(example_value1, example_value2) do the same
+// checks as EXPECT_REGULAR and ASSERT_REGULAR, and record the number of
+// allocations (and bytes) of the special member functions, for each example,
+// as test properties named "memory.<example expression>". Require linking
+// gtest-regular-new-delete.cc into the test program.
+#define EXPECT_REGULAR_MEMORY_PROFILE(example_value1, example_value2)    \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeWithMemoryProfile<false>(                          \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+#define ASSERT_REGULAR_MEMORY_PROFILE(example_value1, example_value2)    \
+  ::example_implementation_by_niels_dekker::                             \
+      CheckRegularTypeWithMemoryProfile<true>(                           \
+          __FILE__, __LINE__, example_value1, #example_value1,           \
+          example_value2, #example_value2)
+
+// EXPECT_REGULAR_RANGE(examples) and ASSERT_REGULAR_RANGE(examples) check the
+// elements of a range (or a braced-init-list) of different example values.
+// The macro's are variadic, to allow commas inside a braced-init-list.
+#define EXPECT_REGULAR_RANGE(...)                                        \
+  ::example_implementation_by_niels_dekker::CheckRegularRange<false>(    \
+      __FILE__, __LINE__, __VA_ARGS__, #__VA_ARGS__)
+
+#define ASSERT_REGULAR_RANGE(...)                                        \
+  ::example_implementation_by_niels_dekker::CheckRegularRange<true>(     \
+      __FILE__, __LINE__, __VA_ARGS__, #__VA_ARGS__)
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_MACROS_H_
@@ -0,0 +1,234 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Replaces the global operator new and operator delete functions, in order to
+// count the memory allocations and deallocations for EXPECT_REGULAR_NOALLOC,
+// EXPECT_REGULAR_MEMORY_PROFILE and EXPECT_REGULAR_NO_LEAK (and their ASSERT
+// variants). Since C++17, the over-aligned variants (taking an
+// std::align_val_t) are replaced as well. This file should be linked into the
+// test program when using those macro's.
+
+#include "gtest-regular.h"  // For AllocationCounter.
+
+// Standard library header files:
+#include <cstddef>  // For max_align_t and size_t.
+#include <cstdint>  // For uintptr_t.
+#include <cstdlib>  // For malloc and free.
+#include <cstring>  // For memcpy.
+#include <new>  // For align_val_t, bad_alloc, get_new_handler and nothrow_t.
+
+namespace {
+
+using ::example_implementation_by_niels_dekker::AllocationCounter;
+
+// Tells AllocationCounter that the allocation functions are replaced.
+const struct Installer {
+  Installer() { AllocationCounter::Install(); }
+} installer;
+
+// Each block starts with a header that holds the size requested by the user,
+// so that the deallocation functions know how many bytes are freed. The size
+// of the header preserves the alignment of the block returned by malloc.
+constexpr std::size_t header_size{alignof(std::max_align_t)};
+
+// Calls malloc, and, when it fails, the new-handler, as operator new does,
+// until malloc succeeds.
+void* MallocOrCallNewHandler(const std::size_t size) {
+  for (;;) {
+    void* const ptr = std::malloc(size);
+
+    if (ptr != nullptr) {
+      return ptr;
+    }
+    const std::new_handler handler = std::get_new_handler();
+
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void* Allocate(const std::size_t size) {
+  AllocationCounter::OnAllocation(size);
+
+  void* const ptr = MallocOrCallNewHandler(header_size + size);
+  *static_cast<std::size_t*>(ptr) = size;
+  return static_cast<char*>(ptr) + header_size;
+}
+
+void* AllocateNoThrow(const std::size_t size) noexcept {
+  try {
+    return Allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void Deallocate(void* const ptr) noexcept {
+  if (ptr != nullptr) {
+    void* const block = static_cast<char*>(ptr) - header_size;
+    AllocationCounter::OnDeallocation(*static_cast<std::size_t*>(block));
+    std::free(block);
+  }
+}
+
+#ifdef __cpp_aligned_new
+// An over-aligned block is preceded by a header that holds the pointer
+// returned by malloc, and the size requested by the user. The header may be
+// less aligned than its members require, so it is accessed by memcpy.
+struct AlignedHeader {
+  void* malloc_ptr;
+  std::size_t size;
+};
+
+void* AllocateAligned(const std::size_t size,
+                      const std::align_val_t alignment) {
+  AllocationCounter::OnAllocation(size);
+
+  const auto alignment_value = static_cast<std::size_t>(alignment);
+  void* const malloc_ptr = MallocOrCallNewHandler(
+      sizeof(AlignedHeader) + alignment_value - 1 + size);
+  const std::uintptr_t address =
+      reinterpret_cast<std::uintptr_t>(malloc_ptr) + sizeof(AlignedHeader);
+  char* const ptr = static_cast<char*>(malloc_ptr) + sizeof(AlignedHeader) +
+                    (alignment_value - address % alignment_value) %
+                        alignment_value;
+  const AlignedHeader header{malloc_ptr, size};
+  std::memcpy(ptr - sizeof(AlignedHeader), &header, sizeof(AlignedHeader));
+  return ptr;
+}
+
+void* AllocateAlignedNoThrow(const std::size_t size,
+                             const std::align_val_t alignment) noexcept {
+  try {
+    return AllocateAligned(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void DeallocateAligned(void* const ptr) noexcept {
+  if (ptr != nullptr) {
+    AlignedHeader header;
+    std::memcpy(&header, static_cast<char*>(ptr) - sizeof(AlignedHeader),
+                sizeof(AlignedHeader));
+    AllocationCounter::OnDeallocation(header.size);
+    std::free(header.malloc_ptr);
+  }
+}
+#endif
+
+}  // namespace
+
+void* operator new(const std::size_t size) { return Allocate(size); }
+
+void* operator new[](const std::size_t size) { return Allocate(size); }
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+  return AllocateNoThrow(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept {
+  return AllocateNoThrow(size);
+}
+
+void operator delete(void* const ptr) noexcept { Deallocate(ptr); }
+
+void operator delete[](void* const ptr) noexcept { Deallocate(ptr); }
+
+void operator delete(void* const ptr, const std::nothrow_t&) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* const ptr, const std::nothrow_t&) noexcept {
+  Deallocate(ptr);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void* const ptr, std::size_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* const ptr, std::size_t) noexcept {
+  Deallocate(ptr);
+}
+#endif
+
+#ifdef __cpp_aligned_new
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+  return AllocateAligned(size, alignment);
+}
+
+void* operator new[](const std::size_t size,
+                     const std::align_val_t alignment) {
+  return AllocateAligned(size, alignment);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return AllocateAlignedNoThrow(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return AllocateAlignedNoThrow(size, alignment);
+}
+
+void operator delete(void* const ptr, std::align_val_t) noexcept {
+  DeallocateAligned(ptr);
+}
+
+void operator delete[](void* const ptr, std::align_val_t) noexcept {
+  DeallocateAligned(ptr);
+}
+
+void operator delete(void* const ptr, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  DeallocateAligned(ptr);
+}
+
+void operator delete[](void* const ptr, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  DeallocateAligned(ptr);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void* const ptr, std::size_t, std::align_val_t) noexcept {
+  DeallocateAligned(ptr);
+}
+
+void operator delete[](void* const ptr, std::size_t,
+                       std::align_val_t) noexcept {
+  DeallocateAligned(ptr);
+}
+#endif
+#endif
@@ -0,0 +1,276 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro's EXPECT_TOTALLY_ORDERED(examples) and
+// ASSERT_TOTALLY_ORDERED(examples), which check that operator< is a strict
+// total order that is consistent with operator==, over a range (or a
+// braced-init-list) of examples, and which record the cost of operator<,
+// compared to operator==.
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_ORDERING_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_ORDERING_H_
+
+#include <cstddef>  // For size_t.
+#include <deque>
+#include <initializer_list>
+#include <iterator>  // For begin.
+#include <sstream>   // For ostringstream.
+#include <string>
+#include <type_traits>  // For decay.
+#include <utility>      // For move.
+#include <vector>
+
+#include "gtest-regular-complexity.h"  // For MeasureNanosecondsPerCall.
+#include "gtest-regular.h"  // For MakeRangeExamples and ReportFailure.
+#include "gtest/gtest.h"    // For Test::RecordProperty.
+#include "gtest/internal/gtest-type-util.h"  // For GetTypeName.
+
+namespace example_implementation_by_niels_dekker {
+
+// Checks that operator< is irreflexive, asymmetric and transitive, and that
+// two objects compare equal if and only if neither of them compares less than
+// the other. The number of comparisons is cubic in the number of examples.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T>
+class TotalOrderChecker {
+ public:
+  TotalOrderChecker(std::vector<RegularTypeExample> examples,
+                    std::string& message)
+      : examples_(std::move(examples)), message_(message) {}
+
+  bool Check() const {
+    if (examples_.size() < 2) {
+      message_.append("At least two example values are required!");
+      return false;
+    }
+    const std::size_t count = examples_.size();
+
+    for (std::size_t i{}; i < count; ++i) {
+      if (!CheckIrreflexivity(i)) {
+        return false;
+      }
+    }
+    for (std::size_t i{}; i < count; ++i) {
+      for (std::size_t j{}; j < count; ++j) {
+        if (i != j &&
+            !(CheckAsymmetry(i, j) && CheckConsistencyWithEqual(i, j))) {
+          return false;
+        }
+      }
+    }
+    for (std::size_t i{}; i < count; ++i) {
+      for (std::size_t j{}; j < count; ++j) {
+        for (std::size_t k{}; k < count; ++k) {
+          if (!CheckTransitivity(i, j, k)) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  // Records the mean number of nanoseconds per call of operator< and
+  // operator==, over all pairs of examples, as test properties.
+  void RecordComparisonCost() const {
+    ::testing::Test::RecordProperty(
+        "ordering.less_nanoseconds",
+        ToString(MeasureNanosecondsPerComparison(&Operations::Less)));
+    ::testing::Test::RecordProperty(
+        "ordering.equal_nanoseconds",
+        ToString(MeasureNanosecondsPerComparison(&Operations::Equal)));
+  }
+
+ private:
+  struct Operations {
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+    static bool Less(const T& left_operand, const T& right_operand) {
+      return left_operand < right_operand;
+    }
+    static bool Equal(const T& left_operand, const T& right_operand) {
+      return left_operand == right_operand;
+    }
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+  };
+
+  // The comparison is called through a (volatile) function pointer, so that
+  // the compiler cannot optimize it away.
+  double MeasureNanosecondsPerComparison(
+      bool (*const comparison)(const T&, const T&)) const {
+    bool (*volatile compare)(const T&, const T&) = comparison;
+    volatile bool result{};
+    const std::size_t count = examples_.size();
+
+    return MeasureNanosecondsPerCall(
+        [&] {
+          for (std::size_t i{}; i < count; ++i) {
+            for (std::size_t j{}; j < count; ++j) {
+              result = compare(GetValue(i), GetValue(j));
+            }
+          }
+        },
+        static_cast<unsigned>(count * count));
+  }
+
+  static std::string ToString(const double nanoseconds) {
+    std::ostringstream stream;
+    stream.precision(2);
+    stream << std::fixed << nanoseconds;
+    return stream.str();
+  }
+
+  const T& GetValue(const std::size_t example_index) const {
+    return *static_cast<const T*>(examples_[example_index].GetValue());
+  }
+
+  bool Less(const std::size_t left_index, const std::size_t right_index) const {
+    return Operations::Less(GetValue(left_index), GetValue(right_index));
+  }
+
+  void AppendOperands(const std::size_t left_index,
+                      const std::size_t right_index) const {
+    message_.append("\n    Left operand: ")
+        .append(examples_[left_index].ToString())
+        .append("\n    Right operand: ")
+        .append(examples_[right_index].ToString());
+  }
+
+  bool CheckIrreflexivity(const std::size_t example_index) const {
+    if (Less(example_index, example_index)) {
+      message_.append("Object should not compare less than itself!")
+          .append("\n    Value: ")
+          .append(examples_[example_index].ToString());
+      return false;
+    }
+    return true;
+  }
+
+  bool CheckAsymmetry(const std::size_t left_index,
+                      const std::size_t right_index) const {
+    if (Less(left_index, right_index) && Less(right_index, left_index)) {
+      message_.append(
+          "Two objects should not both compare less than each other!");
+      AppendOperands(left_index, right_index);
+      return false;
+    }
+    return true;
+  }
+
+  bool CheckConsistencyWithEqual(const std::size_t left_index,
+                                 const std::size_t right_index) const {
+    const bool is_equivalent =
+        !Less(left_index, right_index) && !Less(right_index, left_index);
+
+    if (is_equivalent ==
+        Operations::Equal(GetValue(left_index), GetValue(right_index))) {
+      return true;
+    }
+    message_.append(
+        is_equivalent
+            ? "Two objects that do not compare less than each other should "
+              "compare equal!"
+            : "Two objects that compare equal should not compare less than "
+              "each other!");
+    AppendOperands(left_index, right_index);
+    return false;
+  }
+
+  bool CheckTransitivity(const std::size_t first_index,
+                         const std::size_t second_index,
+                         const std::size_t third_index) const {
+    if (Less(first_index, second_index) && Less(second_index, third_index) &&
+        !Less(first_index, third_index)) {
+      message_
+          .append(
+              "When a < b and b < c, a < c should hold as well, but it does "
+              "not!\n    a: ")
+          .append(examples_[first_index].ToString())
+          .append("\n    b: ")
+          .append(examples_[second_index].ToString())
+          .append("\n    c: ")
+          .append(examples_[third_index].ToString());
+      return false;
+    }
+    return true;
+  }
+
+  const std::vector<RegularTypeExample> examples_;
+  std::string& message_;
+};
+
+template <bool is_failure_fatal, typename Range>
+void CheckTotalOrder(const char* const file, const int line,
+                     const Range& range, const char* const range_expression) {
+  using T = typename std::decay<decltype(*std::begin(range))>::type;
+
+  std::deque<T> owned_values;
+  std::string message;
+  const TotalOrderChecker<T> checker(
+      MakeRangeExamples(range, range_expression, owned_values), message);
+
+  if (checker.Check()) {
+    checker.RecordComparisonCost();
+  } else {
+    ReportFailure(is_failure_fatal, file, line,
+                  "Type expected to be totally ordered: '" +
+                      testing::internal::GetTypeName<T>() + "'\n  " + message);
+  }
+}
+
+// Overload for a braced-init-list, like `{ 1, 2, 3 }`.
+template <bool is_failure_fatal, typename T>
+void CheckTotalOrder(const char* const file, const int line,
+                     const std::initializer_list<T> range,
+                     const char* const range_expression) {
+  CheckTotalOrder<is_failure_fatal, std::initializer_list<T>>(
+      file, line, range, range_expression);
+}
+
+}  // namespace example_implementation_by_niels_dekker
+
+// EXPECT_TOTALLY_ORDERED(examples) and ASSERT_TOTALLY_ORDERED(examples) check
+// operator< over the elements of a range (or a braced-init-list) of examples.
+// The macro's are variadic, to allow commas inside a braced-init-list.
+#define EXPECT_TOTALLY_ORDERED(...)                                     \
+  ::example_implementation_by_niels_dekker::CheckTotalOrder<false>(     \
+      __FILE__, __LINE__, __VA_ARGS__, #__VA_ARGS__)
+
+#define ASSERT_TOTALLY_ORDERED(...)                                     \
+  ::example_implementation_by_niels_dekker::CheckTotalOrder<true>(      \
+      __FILE__, __LINE__, __VA_ARGS__, #__VA_ARGS__)
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_ORDERING_H_
@@ -0,0 +1,108 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This header file defines the macro REGULAR_TYPED_TEST_SUITE(test_suite_name,
+// types), which defines a typed test suite that checks each of the types of a
+// ::testing::Types<...> list, in the same way as EXPECT_REGULAR_RANGE. The
+// examples of each type are produced by its RegularTypeExampleFactory, which
+// is predefined for arithmetic types, and must be specialized by the user for
+// any other type. For example:
+//
+//   namespace example_implementation_by_niels_dekker {
+//   template <>
+//   struct RegularTypeExampleFactory<std::string> {
+//     static std::vector<std::string> MakeExamples() { return {"a", "b"}; }
+//   };
+//   }
+//
+//   REGULAR_TYPED_TEST_SUITE(MyTypes, ::testing::Types<int, std::string>);
+//
+// Apart from the thunks of RegularTypeThunks<T>, the checks are done by a
+// single non-template driver, CheckRegularExamples, so that the compile time
+// grows slowly with the number of types.
+
+#ifndef GTEST_INCLUDE_GTEST_REGULAR_TYPED_H_
+#define GTEST_INCLUDE_GTEST_REGULAR_TYPED_H_
+
+#include <type_traits>  // For enable_if, is_arithmetic and is_same.
+#include <vector>
+
+#include "gtest-regular.h"  // For CheckRegularExamples.
+#include "gtest/gtest.h"    // For TYPED_TEST and TYPED_TEST_SUITE.
+#include "gtest/internal/gtest-type-util.h"  // For GetTypeName.
+
+namespace example_implementation_by_niels_dekker {
+
+// Produces the examples for REGULAR_TYPED_TEST_SUITE. A specialization must
+// have a static member function MakeExamples(), returning an std::vector<T> of
+// at least two different values.
+template <typename T, typename = void>
+struct RegularTypeExampleFactory;
+
+// The examples of an arithmetic type: zero and one. Note that bool is not
+// supported, as std::vector<bool> does not store its elements contiguously.
+template <typename T>
+struct RegularTypeExampleFactory<
+    T, typename std::enable_if<std::is_arithmetic<T>::value &&
+                               !std::is_same<T, bool>::value>::type> {
+  static std::vector<T> MakeExamples() {
+    return {static_cast<T>(0), static_cast<T>(1)};
+  }
+};
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeByExampleFactory(const char* const file, const int line) {
+  const std::vector<T> examples = RegularTypeExampleFactory<T>::MakeExamples();
+
+  CheckRegularExamples(is_failure_fatal, file, line,
+                       RegularTypeThunks<T>::GetOperations(), examples.data(),
+                       examples.size(),
+                       "RegularTypeExampleFactory<T>::MakeExamples()",
+                       testing::internal::GetTypeName<T>());
+}
+
+}  // namespace example_implementation_by_niels_dekker
+
+// Defines a typed test suite, with one test, named "IsRegular", for each of
+// the types. The macro is variadic, to allow commas inside the type list.
+#define REGULAR_TYPED_TEST_SUITE(test_suite_name, ...)                 \
+  template <typename T>                                                \
+  class test_suite_name : public ::testing::Test {};                   \
+  using test_suite_name##_RegularTypes = __VA_ARGS__;                  \
+  TYPED_TEST_SUITE(test_suite_name, test_suite_name##_RegularTypes, ); \
+  TYPED_TEST(test_suite_name, IsRegular) {                             \
+    ::example_implementation_by_niels_dekker::                         \
+        CheckRegularTypeByExampleFactory<false, TypeParam>(__FILE__,   \
+                                                           __LINE__);  \
+  }                                                                    \
+  static_assert(true, "")
+
+#endif  // GTEST_INCLUDE_GTEST_REGULAR_TYPED_H_
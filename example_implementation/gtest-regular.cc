@@ -0,0 +1,1494 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Implements the type-erased core of EXPECT_REGULAR and its variants: the
+// member functions of RegularTypeChecker, RegularTypeExample and ValueDigest.
+// This file should be linked into the test program.
+
+#include "gtest-regular.h"
+
+// GoogleTest header files:
+#include "gtest/gtest-message.h"    // For Message.
+#include "gtest/gtest-test-part.h"  // For TestPartResult.
+#include "gtest/gtest.h"            // For AssertHelper and Test.
+
+// Standard library header files:
+#include <algorithm>     // For find_if, max and min.
+#include <atomic>        // For atomic.
+#include <chrono>        // For steady_clock.
+#include <cstddef>       // For max_align_t and size_t.
+#include <cstdint>       // For uintptr_t.
+#include <cstring>       // For memcmp, memcpy and memset.
+#include <exception>     // For exception.
+#include <functional>    // For function.
+#include <memory>        // For unique_ptr.
+#include <sstream>       // For ostringstream.
+#include <streambuf>     // For streambuf.
+#include <system_error>  // For system_error.
+#include <thread>
+#include <utility>  // For move.
+
+namespace example_implementation_by_niels_dekker {
+
+// Feeds the characters written to an ostream into a digest.
+class ValueDigest::StreamBuf : public std::streambuf {
+ public:
+  explicit StreamBuf(ValueDigest& digest) : digest_(digest) {}
+
+ protected:
+  int_type overflow(const int_type ch) override {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      const char c = traits_type::to_char_type(ch);
+      digest_.Append(&c, 1, true);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize xsputn(const char* const s,
+                         const std::streamsize n) override {
+    digest_.Append(s, static_cast<std::size_t>(n), true);
+    return n;
+  }
+
+ private:
+  ValueDigest& digest_;
+};
+
+ValueDigest ValueDigest::FromObjectRepresentation(const void* const object,
+                                                  const std::size_t size) {
+  ValueDigest digest;
+  digest.Append(static_cast<const char*>(object), size, false);
+
+  if (size <= kMaxPrefixLength) {
+    std::memcpy(digest.buffer_, object, size);
+    digest.has_object_representation_ = true;
+  }
+  return digest;
+}
+
+ValueDigest ValueDigest::FromPrintout(
+    void (*const print)(const void*, std::ostream*), const void* const value) {
+  ValueDigest digest;
+  StreamBuf stream_buf(digest);
+  std::ostream stream(&stream_buf);
+  print(value, &stream);
+  return digest;
+}
+
+void ValueDigest::Append(const char* const data, const std::size_t size,
+                         const bool is_printout) {
+  for (std::size_t i = 0; i < size; ++i) {
+    hash_ = (hash_ ^ static_cast<unsigned char>(data[i])) *
+            std::uint64_t{1099511628211u};
+  }
+  if (is_printout) {
+    for (std::size_t i = 0; i < size && prefix_length_ < kMaxPrefixLength;
+         ++i) {
+      buffer_[prefix_length_++] = static_cast<unsigned char>(data[i]);
+    }
+    length_ += size;
+  }
+}
+
+namespace {
+
+ValueDigest TakeDigest(const RegularTypeOperations& operations,
+                       const void* const value) {
+  return operations.is_trivially_copyable
+             ? ValueDigest::FromObjectRepresentation(value, operations.size)
+             : ValueDigest::FromPrintout(operations.print, value);
+}
+
+// Takes the digest of the value of an example, and lets the listener (if any)
+// time it, as taking a digest may involve printing the value.
+ValueDigest TakeDigestOfExample(const RegularTypeOperations& operations,
+                                const void* const value) {
+  RegularTypeCheckListener* const listener = RegularTypeChecker::GetListener();
+
+  if (listener == nullptr) {
+    return TakeDigest(operations, value);
+  }
+  const auto start_time = std::chrono::steady_clock::now();
+  const ValueDigest digest = TakeDigest(operations, value);
+  listener->OnCheckTimed("TakeDigest",
+                         std::chrono::steady_clock::now() - start_time);
+  return digest;
+}
+
+std::string PrintValueToString(const RegularTypeOperations& operations,
+                               const void* const value) {
+  std::ostringstream stream;
+  operations.print(value, &stream);
+  return stream.str();
+}
+
+// Returns the average duration of a swap, in nanoseconds, of the fastest of a
+// few rounds of swaps. Each round does an even number of swaps, so that the
+// objects get their original values back.
+double MeasureSwapDuration(void (*const swap)(void*, void*),
+                           void* const object1, void* const object2) {
+  constexpr int kNumberOfRounds{5};
+  constexpr int kNumberOfSwapsPerRound{1000};
+  using Clock = std::chrono::steady_clock;
+  Clock::duration fastest_round = Clock::duration::max();
+
+  for (int round{}; round < kNumberOfRounds; ++round) {
+    const auto start_time = Clock::now();
+
+    for (int i{}; i < kNumberOfSwapsPerRound; ++i) {
+      swap(object1, object2);
+    }
+    fastest_round = std::min(fastest_round, Clock::now() - start_time);
+  }
+  return std::chrono::duration<double, std::nano>(fastest_round).count() /
+         kNumberOfSwapsPerRound;
+}
+
+}  // namespace
+
+namespace {
+
+// The counts of OperationCount, together with their names.
+const struct {
+  std::size_t OperationCount::*count;
+  const char* name;
+} operation_count_names[] = {
+    {&OperationCount::value_initializations, "value-initializations"},
+    {&OperationCount::copy_constructions, "copy-constructions"},
+    {&OperationCount::move_constructions, "move-constructions"},
+    {&OperationCount::copy_assignments, "copy-assignments"},
+    {&OperationCount::move_assignments, "move-assignments"},
+    {&OperationCount::swaps, "swaps"},
+    {&OperationCount::destructions, "destructions"},
+    {&OperationCount::equality_comparisons, "equality comparisons"},
+    {&OperationCount::inequality_comparisons, "inequality comparisons"}};
+
+}  // namespace
+
+std::string OperationCount::ToString() const {
+  std::string result;
+
+  for (const auto& count_name : operation_count_names) {
+    const std::size_t count = this->*count_name.count;
+
+    if (count > 0) {
+      if (!result.empty()) {
+        result.append(", ");
+      }
+      result.append(count_name.name).append(": ").append(std::to_string(count));
+    }
+  }
+  return result.empty() ? "none" : result;
+}
+
+OperationCount OperationCounter::GetCount() const {
+  const OperationCount& current = GetThreadOperationCount();
+  OperationCount result{};
+
+  for (const auto& count_name : operation_count_names) {
+    result.*count_name.count =
+        current.*count_name.count - start_.*count_name.count;
+  }
+  return result;
+}
+
+RegularTypeExample::RegularTypeExample(const RegularTypeOperations& operations,
+                                       const void* const value,
+                                       std::string expression)
+    : operations_(&operations),
+      value_(value),
+      digest_(TakeDigestOfExample(operations, value)),
+      expression_(std::move(expression)) {
+  // Note: only a digest of the value is taken at construction time, in order
+  // to detect any possible changes of value_ during the test. The (possibly
+  // expensive) string representation of the value is only generated by
+  // ToString(), when a failure message is needed.
+}
+
+void RegularTypeExample::UpdateDigest() {
+  digest_ = TakeDigest(*operations_, value_);
+}
+
+bool RegularTypeExample::IsModified() const {
+  return TakeDigest(*operations_, value_) != digest_;
+}
+
+std::string RegularTypeExample::ToString() const {
+  std::string result(expression_);
+  const std::string value_as_string = PrintValueToString(*operations_, value_);
+
+  if (value_as_string != expression_) {
+    result.append("\n    Which is: ").append(value_as_string);
+  }
+  if (IsModified()) {
+    result.append("\n    Note: this example was modified during the test!");
+
+    const void* const original_bytes = digest_.GetObjectRepresentation();
+
+    if (original_bytes != nullptr &&
+        operations_->alignment <= alignof(std::max_align_t)) {
+      result.append("\n    Original value: ")
+          .append(PrintValueToString(*operations_, original_bytes));
+      return result;
+    }
+    const std::string original_prefix = digest_.GetPrefix();
+
+    if (!original_prefix.empty()) {
+      result
+          .append(digest_.IsPrefixComplete()
+                      ? "\n    Original value: "
+                      : "\n    Original value started with: ")
+          .append(original_prefix);
+    }
+  }
+  return result;
+}
+
+// An object of the type to be checked, in storage owned by this class. The
+// storage is allocated by the constructor, separately from the construction
+// of the object itself, so that an allocation of storage is never counted as
+// an allocation by the operation that constructs the object.
+class RegularTypeChecker::Object {
+ public:
+  explicit Object(const RegularTypeOperations& operations)
+      : operations_(operations) {
+    if (operations.size > sizeof(buffer_) ||
+        operations.alignment > alignof(std::max_align_t)) {
+      heap_buffer_.reset(
+          new unsigned char[operations.size + operations.alignment - 1]);
+      const std::uintptr_t address =
+          reinterpret_cast<std::uintptr_t>(heap_buffer_.get());
+      storage_ = heap_buffer_.get() +
+                 (operations.alignment - address % operations.alignment) %
+                     operations.alignment;
+    }
+  }
+
+  Object(const Object&) = delete;
+  Object& operator=(const Object&) = delete;
+
+  ~Object() {
+    if (is_constructed_) {
+      operations_.destruct(storage_);
+    }
+  }
+
+  void ValueInitialize() {
+    operations_.value_initialize(storage_);
+    is_constructed_ = true;
+  }
+
+  void CopyConstruct(const void* const source) {
+    operations_.copy_construct(storage_, source);
+    is_constructed_ = true;
+  }
+
+  void MoveConstruct(Object& source) {
+    operations_.move_construct(storage_, source.Get());
+    is_constructed_ = true;
+  }
+
+  void CopyAssign(const void* const source) {
+    operations_.copy_assign(storage_, source);
+  }
+
+  void MoveAssign(Object& source) {
+    operations_.move_assign(storage_, source.Get());
+  }
+
+  void Swap(Object& other) { operations_.swap(storage_, other.Get()); }
+
+  void GenericSwap(Object& other) {
+    operations_.generic_swap(storage_, other.Get());
+  }
+
+  void Destruct() {
+    operations_.destruct(storage_);
+    is_constructed_ = false;
+  }
+
+  // Relocates the source object into this object, by copying its bytes, and
+  // ends the lifetime of the source object, without calling its destructor.
+  // Scribbles over the storage of the source object, so that the relocated
+  // object cannot silently keep using it.
+  void RelocateBitwise(Object& source) {
+    std::memcpy(storage_, source.storage_, operations_.size);
+    is_constructed_ = true;
+    source.is_constructed_ = false;
+    std::memset(source.storage_, 0xA5, operations_.size);
+  }
+
+  // Ends the lifetime of the object, without calling its destructor, as the
+  // destructor may not be safe to call.
+  void Abandon() { is_constructed_ = false; }
+
+  // Restores the object from a copy of its bytes, taken while it was alive.
+  void RestoreBitwise(const unsigned char* const bytes) {
+    std::memcpy(storage_, bytes, operations_.size);
+    is_constructed_ = true;
+  }
+
+  void* Get() { return storage_; }
+  const void* Get() const { return storage_; }
+
+ private:
+  const RegularTypeOperations& operations_;
+  alignas(std::max_align_t) unsigned char buffer_[64];
+  std::unique_ptr<unsigned char[]> heap_buffer_;
+  unsigned char* storage_{buffer_};
+  bool is_constructed_{false};
+};
+
+RegularTypeChecker::RegularTypeChecker(
+    const RegularTypeOperations& operations, const void* const example_value1,
+    const char* const example_expression1, const void* const example_value2,
+    const char* const example_expression2, std::string& message)
+    : operations_(operations),
+      examples_{
+          RegularTypeExample(operations, example_value1, example_expression1),
+          RegularTypeExample(operations, example_value2, example_expression2)},
+      message_(message) {}
+
+RegularTypeChecker::RegularTypeChecker(
+    const RegularTypeOperations& operations,
+    std::vector<RegularTypeExample> examples, std::string& message)
+    : operations_(operations),
+      examples_(std::move(examples)),
+      message_(message) {}
+
+const RegularTypeChecker::CheckFunction
+    RegularTypeChecker::check_functions[] = {
+        {"CheckEqualToSelf", nullptr, &RegularTypeChecker::CheckEqualToSelf,
+         nullptr},
+        {"CheckUnequal", nullptr, nullptr, &RegularTypeChecker::CheckUnequal},
+        {"CheckValueInitialization",
+         &RegularTypeChecker::CheckValueInitialization, nullptr, nullptr},
+        {"CheckCopyAndMoveConstruct", nullptr,
+         &RegularTypeChecker::CheckCopyAndMoveConstruct, nullptr},
+        {"CheckAssigningDifferentValue", nullptr, nullptr,
+         &RegularTypeChecker::CheckAssigningDifferentValue},
+        {"CheckAssigningItsOriginalValue", nullptr,
+         &RegularTypeChecker::CheckAssigningItsOriginalValue, nullptr},
+        {"CheckSelfAssignment", nullptr,
+         &RegularTypeChecker::CheckSelfAssignment, nullptr},
+        {"CheckCopyValue", nullptr, nullptr,
+         &RegularTypeChecker::CheckCopyValue}};
+
+std::size_t RegularTypeChecker::GetInvocationCount(
+    const CheckFunction& check) const {
+  const std::size_t example_count = examples_.size();
+
+  if (check.check_without_example != nullptr) {
+    return 1;
+  }
+  if (check.check_example != nullptr) {
+    return example_count;
+  }
+  return example_count * (example_count - 1);
+}
+
+bool RegularTypeChecker::RunCheck(const CheckFunction& check,
+                                  const std::size_t invocation_index) const {
+  if (check.check_without_example != nullptr) {
+    return (this->*check.check_without_example)();
+  }
+  if (check.check_example != nullptr) {
+    return (this->*check.check_example)(invocation_index);
+  }
+  // The pairs are ordered like in ForEachPairOfExamples: (0, 1), (0, 2), ...
+  // (1, 0), (1, 2), etc.
+  const std::size_t other_count = examples_.size() - 1;
+  const std::size_t i = invocation_index / other_count;
+  const std::size_t j = invocation_index % other_count;
+  return (this->*check.check_pair_of_examples)(i, (j < i) ? j : j + 1);
+}
+
+std::vector<RegularTypeChecker::Task> RegularTypeChecker::GetTasks() const {
+  std::vector<Task> tasks;
+
+  for (const CheckFunction& check : check_functions) {
+    const std::size_t invocation_count = GetInvocationCount(check);
+
+    for (std::size_t i{}; i < invocation_count; ++i) {
+      tasks.push_back(
+          {check.name, [&check, i](const RegularTypeChecker& checker) {
+             return checker.RunCheck(check, i);
+           }});
+    }
+  }
+  return tasks;
+}
+
+bool RegularTypeChecker::Check() const {
+  if (examples_.size() < 2) {
+    message_.append("At least two different example values are required!");
+    return false;
+  }
+  if (RegularTypeCheckListener* const listener = GetListener()) {
+    return CheckWithListener(*listener);
+  }
+  for (const CheckFunction& check : check_functions) {
+    const std::size_t invocation_count = GetInvocationCount(check);
+
+    for (std::size_t i{}; i < invocation_count; ++i) {
+      if (!RunCheck(check, i)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool RegularTypeChecker::CheckWithListener(
+    RegularTypeCheckListener& listener) const {
+  using Clock = std::chrono::steady_clock;
+
+  for (const CheckFunction& check : check_functions) {
+    const std::size_t invocation_count = GetInvocationCount(check);
+
+    for (std::size_t i{}; i < invocation_count; ++i) {
+      const auto start_time = Clock::now();
+      const bool is_success = RunCheck(check, i);
+      listener.OnCheckTimed(check.name, Clock::now() - start_time);
+
+      if (!is_success) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool RegularTypeChecker::CheckCountingOperations() const {
+  // Adds up the counts of all the invocations of the same check.
+  for (const CheckFunction& check : check_functions) {
+    const std::size_t invocation_count = GetInvocationCount(check);
+    OperationCount total{};
+
+    for (std::size_t i{}; i < invocation_count; ++i) {
+      const OperationCounter counter;
+
+      if (!RunCheck(check, i)) {
+        return false;
+      }
+      const OperationCount count = counter.GetCount();
+
+      for (const auto& count_name : operation_count_names) {
+        total.*count_name.count += count.*count_name.count;
+      }
+    }
+    ::testing::Test::RecordProperty(std::string("operations.") + check.name,
+                                    total.ToString());
+  }
+  return true;
+}
+
+bool RegularTypeChecker::CheckInParallel(unsigned thread_count) const {
+  if (examples_.size() < 2) {
+    message_.append("At least two different example values are required!");
+    return false;
+  }
+  const std::vector<Task> tasks = GetTasks();
+
+  // Each task works on its own copies of the examples, made by the current
+  // thread, before any task is started, so that a copy or an assignment that
+  // modifies its source cannot cause a data race between the tasks.
+  std::vector<std::unique_ptr<Object>> copies;
+  std::vector<std::vector<RegularTypeExample>> task_examples(tasks.size());
+
+  for (std::vector<RegularTypeExample>& examples : task_examples) {
+    for (const RegularTypeExample& example : examples_) {
+      copies.emplace_back(new Object(operations_));
+      Object& copy = *copies.back();
+      copy.CopyConstruct(example.GetValue());
+
+      if (!operations_.equal(copy.Get(), example.GetValue()) ||
+          operations_.unequal(copy.Get(), example.GetValue())) {
+        // The copies cannot replace the examples. Do the checks sequentially
+        // instead, on the examples themselves, as Check() reports the failure.
+        return Check();
+      }
+      examples.push_back(example.WithCopiedValue(copy.Get()));
+
+      if (operations_.is_trivially_copyable && examples.back().IsModified()) {
+        // The copy is not bytewise identical to the example (which may happen
+        // with padding bytes), so it cannot share the digest of the example.
+        examples.back().UpdateDigest();
+      }
+    }
+  }
+
+  // Each task has its own message and its own result. Note that
+  // std::vector<bool> is avoided, as its elements cannot be written
+  // concurrently.
+  std::vector<std::string> messages(tasks.size());
+  std::vector<char> results(tasks.size());
+  std::atomic<std::size_t> next_task_index{0};
+
+  const auto run_tasks = [this, &tasks, &task_examples, &messages, &results,
+                          &next_task_index] {
+    for (std::size_t i = next_task_index++; i < tasks.size();
+         i = next_task_index++) {
+      // Let the task append to its own message. An exception thrown by the
+      // type under test must not escape the thread, as that would terminate
+      // the test program, so it becomes the failure message of the task.
+      const RegularTypeChecker task_checker(
+          operations_, std::move(task_examples[i]), messages[i]);
+      try {
+        results[i] = tasks[i].run(task_checker);
+      } catch (const std::exception& exception) {
+        messages[i].append(tasks[i].name)
+            .append(" threw an exception: ")
+            .append(exception.what());
+        results[i] = false;
+      } catch (...) {
+        messages[i].append(tasks[i].name)
+            .append(" threw an exception of an unknown type");
+        results[i] = false;
+      }
+    }
+  };
+
+  if (thread_count == 0) {
+    thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  {
+    // Joins the threads, also when an exception is thrown while starting them.
+    struct ThreadJoiner {
+      std::vector<std::thread> threads;
+
+      ~ThreadJoiner() {
+        for (std::thread& thread : threads) {
+          thread.join();
+        }
+      }
+    } joiner;
+
+    // The current thread is one of the workers. When no more threads can be
+    // started, the started ones (including the current thread) do the
+    // remaining tasks.
+    for (unsigned i{1}; i < thread_count && i < tasks.size(); ++i) {
+      try {
+        joiner.threads.emplace_back(run_tasks);
+      } catch (const std::system_error&) {
+        break;
+      }
+    }
+    run_tasks();
+  }
+
+  // Merge the messages of the failed tasks, in the order of Check().
+  bool is_success{true};
+
+  for (std::size_t i{}; i < tasks.size(); ++i) {
+    if (!results[i]) {
+      if (!is_success) {
+        message_.append("\n  ");
+      }
+      message_.append(messages[i]);
+      is_success = false;
+    }
+  }
+  return is_success;
+}
+
+void RegularTypeChecker::UpdateExampleDigests() {
+  for (RegularTypeExample& example : examples_) {
+    example.UpdateDigest();
+  }
+}
+
+bool RegularTypeChecker::CheckNoAllocation() const {
+  if (!AllocationCounter::IsInstalled()) {
+    message_.append(
+        "Allocation counting requires linking gtest-regular-new-delete.cc "
+        "into the test program!");
+    return false;
+  }
+  return CheckValueInitializationWithoutAllocation() &&
+         ForEachExample(
+             &RegularTypeChecker::CheckMoveConstructWithoutAllocation) &&
+         ForEachExample(
+             &RegularTypeChecker::CheckMoveAssignWithoutAllocation) &&
+         ForEachExample(&RegularTypeChecker::CheckSwapWithoutAllocation);
+}
+
+bool RegularTypeChecker::CheckNothrowMove() const {
+  if (!operations_.is_nothrow_move_constructible) {
+    message_.append("Move-construction should be noexcept!");
+    return false;
+  }
+  if (!operations_.is_nothrow_move_assignable) {
+    message_.append("Move-assignment should be noexcept!");
+    return false;
+  }
+  if (!operations_.is_nothrow_swappable) {
+    message_.append("Swap should be noexcept!");
+    return false;
+  }
+  return ForEachExample(&RegularTypeChecker::CheckVectorReallocationMoves);
+}
+
+bool RegularTypeChecker::CheckSwap() const {
+  if (!operations_.is_nothrow_swappable) {
+    message_.append("Swap should be noexcept!");
+    return false;
+  }
+  if (!AllocationCounter::IsInstalled()) {
+    message_.append(
+        "Allocation counting requires linking gtest-regular-new-delete.cc "
+        "into the test program!");
+    return false;
+  }
+  return ForEachPairOfExamples(
+             &RegularTypeChecker::CheckSwapExchangingValues) &&
+         ForEachExample(&RegularTypeChecker::CheckSwapWithMovedFrom) &&
+         ForEachExample(&RegularTypeChecker::CheckSelfSwap) &&
+         ForEachExample(&RegularTypeChecker::CheckSwapWithoutAllocation);
+}
+
+void RegularTypeChecker::RecordSwapSpeed(const std::string& type_name) const {
+  double custom_swap_duration{};
+  double generic_swap_duration{};
+  RecordSwapDurations(type_name, custom_swap_duration, generic_swap_duration);
+}
+
+bool RegularTypeChecker::CheckSwapSpeed(const std::string& type_name) const {
+  // A custom swap is only reported as slow when it is both more than twice as
+  // slow as the generic swap, and more than a few nanoseconds slower, to
+  // avoid false alarms caused by the inaccuracy of the measurements.
+  constexpr double kMaxSlowdownFactor{2.0};
+  constexpr double kMaxSlowdownInNanoseconds{5.0};
+
+  double custom_swap_duration{};
+  double generic_swap_duration{};
+  const std::string property = RecordSwapDurations(
+      type_name, custom_swap_duration, generic_swap_duration);
+
+  if (!operations_.has_custom_swap ||
+      custom_swap_duration <= kMaxSlowdownFactor * generic_swap_duration ||
+      custom_swap_duration <=
+          generic_swap_duration + kMaxSlowdownInNanoseconds) {
+    return true;
+  }
+  message_
+      .append(
+          "The custom swap should not be slower than the generic swap, by "
+          "three moves!\n    Durations: ")
+      .append(property);
+  return false;
+}
+
+bool RegularTypeChecker::CheckTriviallyRelocatable(
+    const std::string& type_name) const {
+  const bool is_trivially_relocatable =
+      ForEachExample(&RegularTypeChecker::CheckBitwiseRelocation);
+  ::testing::Test::RecordProperty("trivially_relocatable." + type_name,
+                                  is_trivially_relocatable ? "true" : "false");
+  return is_trivially_relocatable;
+}
+
+bool RegularTypeChecker::CheckWithoutLeaks() const {
+  if (!AllocationCounter::IsInstalled()) {
+    message_.append(
+        "Allocation counting requires linking gtest-regular-new-delete.cc "
+        "into the test program!");
+    return false;
+  }
+  if (examples_.size() < 2) {
+    return Check();
+  }
+  for (const CheckFunction& check : check_functions) {
+    const std::size_t invocation_count = GetInvocationCount(check);
+
+    for (std::size_t i{}; i < invocation_count; ++i) {
+      const AllocationCounter counter;
+
+      if (!RunCheck(check, i)) {
+        return false;
+      }
+      const AllocationCount count = counter.GetCount();
+
+      if (count.bytes > count.deallocated_bytes) {
+        message_.append(check.name)
+            .append(" should not leak memory!\n    Leaked: ")
+            .append(std::to_string(count.bytes - count.deallocated_bytes))
+            .append(" bytes\n    Allocations: ")
+            .append(std::to_string(count.allocations))
+            .append(" (")
+            .append(std::to_string(count.bytes))
+            .append(" bytes)\n    Deallocations: ")
+            .append(std::to_string(count.deallocations))
+            .append(" (")
+            .append(std::to_string(count.deallocated_bytes))
+            .append(" bytes)");
+
+        for (const RegularTypeExample& example : examples_) {
+          message_.append("\n    Example: ").append(example.ToString());
+        }
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool RegularTypeChecker::RecordMemoryProfile() const {
+  if (!AllocationCounter::IsInstalled()) {
+    message_.append(
+        "Allocation counting requires linking gtest-regular-new-delete.cc "
+        "into the test program!");
+    return false;
+  }
+  const auto to_string = [](const AllocationCount& count) {
+    return std::to_string(count.allocations) +
+           (count.allocations == 1 ? " allocation (" : " allocations (") +
+           std::to_string(count.bytes) + " bytes)";
+  };
+
+  {
+    Object value_initialized(operations_);
+    const AllocationCounter counter;
+    value_initialized.ValueInitialize();
+    ::testing::Test::RecordProperty("memory.value_initialization",
+                                    to_string(counter.GetCount()));
+  }
+
+  for (std::size_t i{}; i < examples_.size(); ++i) {
+    Object copy(operations_);
+    Object target(operations_);
+    Object moved(operations_);
+    target.CopyConstruct(GetExampleValue(GetOtherIndex(i)));
+
+    const AllocationCounter copy_construction_counter;
+    copy.CopyConstruct(GetExampleValue(i));
+    const AllocationCount copy_construction =
+        copy_construction_counter.GetCount();
+
+    const AllocationCounter copy_assignment_counter;
+    target.CopyAssign(GetExampleValue(i));
+    const AllocationCount copy_assignment = copy_assignment_counter.GetCount();
+
+    const AllocationCounter move_construction_counter;
+    moved.MoveConstruct(copy);
+    const AllocationCount move_construction =
+        move_construction_counter.GetCount();
+
+    const AllocationCounter destruction_counter;
+    moved.Destruct();
+    const AllocationCount destruction = destruction_counter.GetCount();
+
+    ::testing::Test::RecordProperty(
+        "memory." + GetExample(i).GetExpression(),
+        "copy-construction: " + to_string(copy_construction) +
+            ", copy-assignment: " + to_string(copy_assignment) +
+            ", move-construction: " + to_string(move_construction) +
+            ", destruction: " + std::to_string(destruction.deallocations) +
+            (destruction.deallocations == 1 ? " deallocation ("
+                                            : " deallocations (") +
+            std::to_string(destruction.deallocated_bytes) + " bytes)");
+  }
+  return true;
+}
+
+void RegularTypeChecker::RecordNoexceptProperty(
+    const std::string& type_name) const {
+  const auto to_string = [](const bool is_nothrow) {
+    return is_nothrow ? "noexcept" : "noexcept(false)";
+  };
+  ::testing::Test::RecordProperty(
+      "noexcept." + type_name,
+      std::string("move-construction: ")
+          .append(to_string(operations_.is_nothrow_move_constructible))
+          .append(", move-assignment: ")
+          .append(to_string(operations_.is_nothrow_move_assignable))
+          .append(", swap: ")
+          .append(to_string(operations_.is_nothrow_swappable)));
+}
+
+void RegularTypeChecker::RecordTrivialityReport(
+    const std::string& type_name) const {
+  const auto to_string = [](const bool is_trivial) {
+    return is_trivial ? "true" : "false";
+  };
+  ::testing::Test::RecordProperty(
+      "triviality." + type_name,
+      std::string("trivially copyable: ")
+          .append(to_string(operations_.is_trivially_copyable))
+          .append(", trivially destructible: ")
+          .append(to_string(operations_.is_trivially_destructible))
+          .append(", trivially default constructible: ")
+          .append(to_string(operations_.is_trivially_default_constructible)));
+
+  // A type whose copies hold resources (like a pointer to memory that is
+  // freed by its destructor) may also yield bytewise identical copies, but
+  // such a type is not trivially destructible.
+  if (!operations_.is_trivially_copyable &&
+      operations_.is_trivially_destructible &&
+      ForEachExample(&RegularTypeChecker::IsCopyBytewise)) {
+    ::testing::Test::RecordProperty(
+        "triviality_advisory." + type_name,
+        "could be trivially copyable: its copy and move operations yield "
+        "bytewise identical copies of the examples, so they might be "
+        "defaulted");
+  }
+}
+
+bool RegularTypeChecker::Equal(const void* const left_operand,
+                               const void* const right_operand) const {
+  return operations_.equal(left_operand, right_operand);
+}
+
+bool RegularTypeChecker::Unequal(const void* const left_operand,
+                                 const void* const right_operand) const {
+  return operations_.unequal(left_operand, right_operand);
+}
+
+std::string RegularTypeChecker::PrintToString(const void* const value) const {
+  return PrintValueToString(operations_, value);
+}
+
+const RegularTypeExample& RegularTypeChecker::GetExample(
+    const std::size_t example_index) const {
+  return examples_[example_index];
+}
+
+const void* RegularTypeChecker::GetExampleValue(
+    const std::size_t example_index) const {
+  return GetExample(example_index).GetValue();
+}
+
+std::size_t RegularTypeChecker::GetOtherIndex(
+    const std::size_t example_index) const {
+  // Returns the index of the example that is used as "other value" by the
+  // checks that involve a single example.
+  return (example_index + 1) % examples_.size();
+}
+
+bool RegularTypeChecker::ForEachExample(
+    bool (RegularTypeChecker::*const check)(std::size_t) const) const {
+  for (std::size_t i{}; i < examples_.size(); ++i) {
+    if (!(this->*check)(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RegularTypeChecker::ForEachPairOfExamples(
+    bool (RegularTypeChecker::*const check)(std::size_t, std::size_t)
+        const) const {
+  for (std::size_t i{}; i < examples_.size(); ++i) {
+    for (std::size_t j{}; j < examples_.size(); ++j) {
+      if (i != j && !(this->*check)(i, j)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool RegularTypeChecker::CheckEqualToExample(
+    const std::size_t example_index, const void* const value,
+    const char* const short_message) const {
+  const RegularTypeExample& example = GetExample(example_index);
+
+  if (Unequal(value, example.GetValue())) {
+    message_.append(short_message)
+        .append("\n    Actual value: ")
+        .append(PrintToString(value))
+        .append("\n    Compares unequal to: ")
+        .append(example.ToString());
+    return false;
+  }
+  return true;
+}
+
+bool RegularTypeChecker::CheckNoAllocationByOperation(
+    const AllocationCounter& counter, const char* const operation_name,
+    const std::size_t example_index) const {
+  const AllocationCount count = counter.GetCount();
+
+  if (count.allocations == 0) {
+    return true;
+  }
+  message_.append(operation_name)
+      .append(" should not allocate memory!\n    Allocations: ")
+      .append(std::to_string(count.allocations))
+      .append(" (")
+      .append(std::to_string(count.bytes))
+      .append(" bytes)\n    Example: ")
+      .append(GetExample(example_index).ToString());
+  return false;
+}
+
+bool RegularTypeChecker::CheckValueInitializationWithoutAllocation() const {
+  Object value_initialized(operations_);
+  const AllocationCounter counter;
+  value_initialized.ValueInitialize();
+  const AllocationCount count = counter.GetCount();
+
+  if (count.allocations == 0) {
+    return true;
+  }
+  message_
+      .append(
+          "Value-initialization should not allocate memory!"
+          "\n    Allocations: ")
+      .append(std::to_string(count.allocations))
+      .append(" (")
+      .append(std::to_string(count.bytes))
+      .append(" bytes)\n    Value-initialized object: ")
+      .append(PrintToString(value_initialized.Get()));
+  return false;
+}
+
+bool RegularTypeChecker::CheckMoveConstructWithoutAllocation(
+    const std::size_t example_index) const {
+  Object source(operations_);
+  source.CopyConstruct(GetExampleValue(example_index));
+  Object target(operations_);
+  const AllocationCounter counter;
+  target.MoveConstruct(source);
+  return CheckNoAllocationByOperation(counter, "Move-construction",
+                                      example_index);
+}
+
+bool RegularTypeChecker::CheckMoveAssignWithoutAllocation(
+    const std::size_t example_index) const {
+  Object target(operations_);
+  target.CopyConstruct(GetExampleValue(GetOtherIndex(example_index)));
+  Object source(operations_);
+  source.CopyConstruct(GetExampleValue(example_index));
+  const AllocationCounter counter;
+  target.MoveAssign(source);
+  return CheckNoAllocationByOperation(counter, "Move-assignment",
+                                      example_index);
+}
+
+bool RegularTypeChecker::CheckSwapWithoutAllocation(
+    const std::size_t example_index) const {
+  Object value(operations_);
+  value.CopyConstruct(GetExampleValue(example_index));
+  Object other_value(operations_);
+  other_value.CopyConstruct(GetExampleValue(GetOtherIndex(example_index)));
+  const AllocationCounter counter;
+  value.Swap(other_value);
+  return CheckNoAllocationByOperation(counter, "Swap", example_index);
+}
+
+bool RegularTypeChecker::CheckSwapExchangingValues(
+    const std::size_t example_index, const std::size_t other_index) const {
+  Object value(operations_);
+  value.CopyConstruct(GetExampleValue(example_index));
+  Object other_value(operations_);
+  other_value.CopyConstruct(GetExampleValue(other_index));
+  value.Swap(other_value);
+
+  return CheckEqualToExample(
+             other_index, value.Get(),
+             "After a swap, the first object must have the original value of "
+             "the second object.") &&
+         CheckEqualToExample(
+             example_index, other_value.Get(),
+             "After a swap, the second object must have the original value of "
+             "the first object.");
+}
+
+bool RegularTypeChecker::CheckSwapWithMovedFrom(
+    const std::size_t example_index) const {
+  Object value(operations_);
+  value.CopyConstruct(GetExampleValue(example_index));
+  Object moved_from(operations_);
+  moved_from.CopyConstruct(GetExampleValue(GetOtherIndex(example_index)));
+  Object moved_to(operations_);
+  moved_to.MoveConstruct(moved_from);
+  moved_from.Swap(value);
+
+  if (CheckEqualToExample(
+          example_index, moved_from.Get(),
+          "A moved-from object must get the value of the object that it is "
+          "swapped with.")) {
+    value.Swap(moved_from);
+
+    return CheckEqualToExample(
+        example_index, value.Get(),
+        "An object must get its original value back, when it is swapped "
+        "twice with a moved-from object.");
+  }
+  return false;
+}
+
+bool RegularTypeChecker::CheckSelfSwap(const std::size_t example_index) const {
+  Object value(operations_);
+  value.CopyConstruct(GetExampleValue(example_index));
+  value.Swap(value);
+
+  return CheckEqualToExample(
+      example_index, value.Get(),
+      "A self-swapped object must have the same value as before.");
+}
+
+std::string RegularTypeChecker::RecordSwapDurations(
+    const std::string& type_name, double& custom_swap_duration,
+    double& generic_swap_duration) const {
+  Object value1(operations_);
+  value1.CopyConstruct(GetExampleValue(0));
+  Object value2(operations_);
+  value2.CopyConstruct(GetExampleValue(1));
+
+  generic_swap_duration = MeasureSwapDuration(operations_.generic_swap,
+                                              value1.Get(), value2.Get());
+
+  std::ostringstream property;
+  property.setf(std::ios::fixed);
+  property.precision(1);
+
+  if (operations_.has_custom_swap) {
+    custom_swap_duration =
+        MeasureSwapDuration(operations_.swap, value1.Get(), value2.Get());
+    property << "custom swap: " << custom_swap_duration
+             << " ns, generic swap: " << generic_swap_duration << " ns";
+
+    if (generic_swap_duration > 0.0) {
+      property.precision(2);
+      property << ", ratio: " << custom_swap_duration / generic_swap_duration;
+    }
+  } else {
+    property << "generic swap: " << generic_swap_duration << " ns";
+  }
+  ::testing::Test::RecordProperty("swap." + type_name, property.str());
+  return property.str();
+}
+
+bool RegularTypeChecker::CheckBitwiseRelocation(
+    const std::size_t example_index) const {
+  const std::size_t other_index = GetOtherIndex(example_index);
+  Object source(operations_);
+  source.CopyConstruct(GetExampleValue(example_index));
+
+  // Keeps the original bytes, to restore the source object when the relocated
+  // object turns out to be broken (before it is assigned to), so that it can
+  // be destructed safely.
+  const std::vector<unsigned char> original_bytes(
+      static_cast<const unsigned char*>(source.Get()),
+      static_cast<const unsigned char*>(source.Get()) + operations_.size);
+
+  Object relocated(operations_);
+  relocated.RelocateBitwise(source);
+
+  const auto is_copy_equal_to_example = [this, example_index, &relocated] {
+    Object copy(operations_);
+    copy.CopyConstruct(relocated.Get());
+    return CheckEqualToExample(example_index, copy.Get(),
+                               "A copy of a bitwise relocated object must have "
+                               "a value equal to the original.");
+  };
+
+  if (!(CheckEqualToExample(example_index, relocated.Get(),
+                            "A bitwise relocated object (relocated by memcpy) "
+                            "must have a value equal to the original.") &&
+        is_copy_equal_to_example())) {
+    // The relocated object still has the original bytes, so the source object
+    // can take them back, and be destructed instead.
+    relocated.Abandon();
+    source.RestoreBitwise(original_bytes.data());
+    return false;
+  }
+
+  relocated.CopyAssign(GetExampleValue(other_index));
+
+  if (CheckEqualToExample(
+          other_index, relocated.Get(),
+          "The target of a copy-assignment must get a value equal to the "
+          "source, even when the target object was bitwise relocated.")) {
+    return true;
+  }
+  // The copy-assignment may have released the resources that the original
+  // bytes refer to, so restoring the source object could free them twice.
+  // Leak the relocated object instead.
+  relocated.Abandon();
+  return false;
+}
+
+bool RegularTypeChecker::IsCopyBytewise(
+    const std::size_t example_index) const {
+  const void* const example_value = GetExampleValue(example_index);
+  const void* const other_value = GetExampleValue(GetOtherIndex(example_index));
+  const auto is_bytewise_equal_to_example = [this, example_value](
+                                                const Object& object) {
+    return std::memcmp(object.Get(), example_value, operations_.size) == 0;
+  };
+
+  Object copy_constructed(operations_);
+  copy_constructed.CopyConstruct(example_value);
+  Object copy_assigned(operations_);
+  copy_assigned.CopyConstruct(other_value);
+  copy_assigned.CopyAssign(example_value);
+
+  if (!(is_bytewise_equal_to_example(copy_constructed) &&
+        is_bytewise_equal_to_example(copy_assigned))) {
+    return false;
+  }
+  Object move_constructed(operations_);
+  move_constructed.MoveConstruct(copy_constructed);
+  Object move_assigned(operations_);
+  move_assigned.CopyConstruct(other_value);
+  move_assigned.MoveAssign(copy_assigned);
+
+  return is_bytewise_equal_to_example(move_constructed) &&
+         is_bytewise_equal_to_example(move_assigned);
+}
+
+bool RegularTypeChecker::CheckVectorReallocationMoves(
+    const std::size_t example_index) const {
+  const std::size_t copy_count =
+      operations_.count_vector_reallocation_copies(
+          GetExampleValue(example_index));
+
+  if (copy_count == 0) {
+    return true;
+  }
+  message_
+      .append(
+          "The reallocations of an std::vector should move its elements, "
+          "rather than copying them!\n    Copies: ")
+      .append(std::to_string(copy_count))
+      .append("\n    Example: ")
+      .append(GetExample(example_index).ToString());
+  return false;
+}
+
+bool RegularTypeChecker::CheckValueInitialization() const {
+  Object value_initialized1(operations_);
+  value_initialized1.ValueInitialize();
+  Object value_initialized2(operations_);
+  value_initialized2.ValueInitialize();
+
+  if (Unequal(value_initialized1.Get(), value_initialized2.Get())) {
+    message_
+        .append(
+            "Value-initialization should always yield the same value"
+            "\n    Value-initialized object 1: ")
+        .append(PrintToString(value_initialized1.Get()))
+        .append("\n    Value-initialized object 2: ")
+        .append(PrintToString(value_initialized2.Get()));
+
+    return false;
+  }
+  return true;
+}
+
+bool RegularTypeChecker::CheckEqualToSelf(
+    const std::size_t example_index) const {
+  const RegularTypeExample& example = GetExample(example_index);
+
+  const void* const value = example.GetValue();
+
+  if (Equal(value, value)) {
+    if (!Unequal(value, value)) {
+      return true;
+    }
+    message_.append("Object should not compare unequal to itself!");
+  } else {
+    message_.append("Object should compare equal to itself!");
+  }
+  message_.append("\n    Value: ").append(example.ToString());
+  return false;
+}
+
+bool RegularTypeChecker::CheckUnequal(const std::size_t left_index,
+                                      const std::size_t right_index) const {
+  const RegularTypeExample& left_example = GetExample(left_index);
+  const RegularTypeExample& right_example = GetExample(right_index);
+  const void* const left_operand = left_example.GetValue();
+  const void* const right_operand = right_example.GetValue();
+
+  if (Equal(left_operand, right_operand)) {
+    message_.append("The two examples should not compare equal!");
+  } else {
+    if (Unequal(left_operand, right_operand)) {
+      return true;
+    }
+    message_.append("The two examples should compare unequal!");
+  }
+
+  message_.append("\n    Left operand: ")
+      .append(left_example.ToString())
+      .append("\n    Right operand: ")
+      .append(right_example.ToString());
+  return false;
+}
+
+bool RegularTypeChecker::CheckCopyAndMoveConstruct(
+    const std::size_t example_index) const {
+  const std::size_t other_index = GetOtherIndex(example_index);
+  const void* const example_value = GetExampleValue(example_index);
+  Object copied_value(operations_);
+  copied_value.CopyConstruct(example_value);
+
+  if (CheckEqualToExample(
+          example_index, copied_value.Get(),
+          "A copy-constructed object must have a value equal to the "
+          "original.")) {
+    Object non_const_lvalue(operations_);
+    non_const_lvalue.CopyConstruct(example_value);
+    Object moved_value(operations_);
+    moved_value.MoveConstruct(non_const_lvalue);
+
+    if (CheckEqualToExample(
+            example_index, moved_value.Get(),
+            "A move-constructed object must have a value equal to the "
+            "original.")) {
+      non_const_lvalue.CopyAssign(GetExampleValue(other_index));
+
+      return CheckEqualToExample(
+          other_index, non_const_lvalue.Get(),
+          "The target of a copy-assignment must get a value equal to the "
+          "source, even when the target object was previously moved-from (as "
+          "source of a move-construction).");
+    }
+  }
+  return false;
+}
+
+bool RegularTypeChecker::CheckAssigningDifferentValue(
+    const std::size_t example_index, const std::size_t other_index) const {
+  const void* const initial_target_value = GetExampleValue(other_index);
+  Object const_source(operations_);
+  const_source.CopyConstruct(GetExampleValue(example_index));
+  Object copy_assign_target(operations_);
+  copy_assign_target.CopyConstruct(initial_target_value);
+  copy_assign_target.CopyAssign(const_source.Get());
+
+  if (CheckEqualToExample(
+          example_index, copy_assign_target.Get(),
+          "A copy-assigned-to object must have a value equal to the "
+          "source object.")) {
+    if (CheckEqualToExample(
+            example_index, const_source.Get(),
+            "The source object of a copy-assignment must preserve its "
+            "value.")) {
+      Object move_assign_target(operations_);
+      move_assign_target.CopyConstruct(initial_target_value);
+
+      Object non_const_source(operations_);
+      non_const_source.CopyConstruct(const_source.Get());
+      move_assign_target.MoveAssign(non_const_source);
+
+      return CheckEqualToExample(
+          example_index, move_assign_target.Get(),
+          "The value of a move-assigned-to object must be equal to the "
+          "original value of the source object.");
+    }
+  }
+  return false;
+}
+
+bool RegularTypeChecker::CheckCopyValue(const std::size_t example_index,
+                                        const std::size_t other_index) const {
+  const void* const source = GetExampleValue(example_index);
+  Object value_initialized(operations_);
+  value_initialized.ValueInitialize();
+
+  if (Unequal(source, value_initialized.Get())) {
+    {
+      Object copy_construct_target(operations_);
+      copy_construct_target.CopyConstruct(source);
+      Object assign_source(operations_);
+      assign_source.ValueInitialize();
+      copy_construct_target.MoveAssign(assign_source);
+    }
+    if (Equal(source, value_initialized.Get())) {
+      message_ +=
+          "Assigning T() to a copy-constructed object should not "
+          "affect the source of the copy-construction.";
+      return false;
+    }
+    {
+      Object assign_target(operations_);
+      assign_target.ValueInitialize();
+      assign_target.CopyAssign(source);
+      Object assign_source(operations_);
+      assign_source.ValueInitialize();
+      assign_target.MoveAssign(assign_source);
+    }
+    if (Equal(source, value_initialized.Get())) {
+      message_ +=
+          "Assigning T() to a copy-assigned-to object should not "
+          "affect the source of the previous assignment.";
+      return false;
+    }
+  }
+  Object target(operations_);
+  target.CopyConstruct(source);
+
+  const void* const other_source = GetExampleValue(other_index);
+  target.CopyAssign(other_source);
+
+  if (Equal(source, other_source)) {
+    message_ +=
+        "Assigning a new value to a copy-constructed-to object should not "
+        "affect the source of the copy-construction.";
+    return false;
+  }
+
+  return true;
+}
+
+bool RegularTypeChecker::CheckSelfAssignment(
+    const std::size_t example_index) const {
+  const std::size_t other_index = GetOtherIndex(example_index);
+  const RegularTypeExample& example = GetExample(example_index);
+
+  Object value(operations_);
+  value.CopyConstruct(example.GetValue());
+  value.CopyAssign(value.Get());
+
+  if (CheckEqualToExample(
+          example_index, value.Get(),
+          "A self-assigned object must have the same value as before.")) {
+    value.MoveAssign(value);
+
+    if (Equal(value.Get(), value.Get())) {
+      value.CopyAssign(GetExampleValue(other_index));
+
+      return CheckEqualToExample(
+          other_index, value.Get(),
+          "When an object is first self-move-assigned and then copy-assigned "
+          "to, its value must compare equal to the source of the "
+          "copy-assignment.");
+    }
+    message_
+        .append("A self-move-assigned object must (still) be equal to itself.")
+        .append("\n    Failed for: ")
+        .append(example.ToString());
+  }
+  return false;
+}
+
+bool RegularTypeChecker::CheckAssigningItsOriginalValue(
+    const std::size_t example_index) const {
+  const void* const example_value = GetExampleValue(example_index);
+  Object value(operations_);
+  value.CopyConstruct(example_value);
+  value.CopyAssign(example_value);
+
+  if (CheckEqualToExample(
+          example_index, value.Get(),
+          "The value of an object must be equal to its original value, when "
+          "it is copy-assigned the same value.")) {
+    Object same_value(operations_);
+    same_value.CopyConstruct(example_value);
+    value.MoveAssign(same_value);
+
+    return CheckEqualToExample(
+        example_index, value.Get(),
+        "The value of an object must be equal to its original value, when it "
+        "is move-assigned the same value.");
+  }
+  return false;
+}
+
+void CheckTimingRecorder::OnCheckTimed(
+    const char* const check_name, const std::chrono::nanoseconds duration) {
+  const void* const test_info =
+      ::testing::UnitTest::GetInstance()->current_test_info();
+
+  if (test_info != test_info_) {
+    test_info_ = test_info;
+    durations_.clear();
+  }
+  const auto found = std::find_if(
+      durations_.begin(), durations_.end(),
+      [check_name](const std::pair<std::string, std::chrono::nanoseconds>&
+                       name_and_duration) {
+        return name_and_duration.first == check_name;
+      });
+  std::chrono::nanoseconds total_duration = duration;
+
+  if (found == durations_.end()) {
+    durations_.emplace_back(check_name, duration);
+  } else {
+    found->second += duration;
+    total_duration = found->second;
+  }
+  ::testing::Test::RecordProperty(std::string("timing.") + check_name,
+                                  std::to_string(total_duration.count()));
+}
+
+void CheckRegularExamples(const bool is_failure_fatal, const char* const file,
+                          const int line,
+                          const RegularTypeOperations& operations,
+                          const void* const examples,
+                          const std::size_t example_count,
+                          const char* const examples_expression,
+                          const std::string& type_name) {
+  std::vector<RegularTypeExample> example_vector;
+  example_vector.reserve(example_count);
+
+  for (std::size_t i{}; i < example_count; ++i) {
+    example_vector.push_back(RegularTypeExample(
+        operations, static_cast<const char*>(examples) + i * operations.size,
+        std::string(examples_expression) + '[' + std::to_string(i) + ']'));
+  }
+
+  std::string message;
+  const RegularTypeChecker checker(operations, std::move(example_vector),
+                                   message);
+
+  if (!checker.Check()) {
+    ReportIrregularType(is_failure_fatal, file, line, type_name, message);
+  } else if (RegularTypeChecker::IsTrivialityReportEnabled()) {
+    checker.RecordTrivialityReport(type_name);
+  }
+}
+
+void ReportFailure(const bool is_failure_fatal, const char* const file,
+                   const int line, const std::string& message) {
+  using namespace ::testing;
+  const TestPartResult::Type result_type{
+      is_failure_fatal ? TestPartResult::kFatalFailure
+                       : TestPartResult::kNonFatalFailure};
+  // Assign Message() to enable streaming; see AssertHelper::operator=.
+  ::testing::internal::AssertHelper(result_type, file, line, message.c_str()) =
+      Message();
+}
+
+void ReportIrregularType(const bool is_failure_fatal, const char* const file,
+                         const int line, const std::string& type_name,
+                         const std::string& message) {
+  ReportFailure(is_failure_fatal, file, line,
+                "Type expected to be regular: '" + type_name + "'\n  " +
+                    message);
+}
+
+}  // namespace example_implementation_by_niels_dekker
@@ -0,0 +1,78 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// This file is the interface unit of the C++20 module gtest_regular, which
+// exports the declarations of gtest-regular.h. Importing the module, instead of
+// including gtest-regular.h, spares each test translation unit the parsing of
+// gtest-regular.h and the standard library headers it includes. As a module
+// does not export macro's, a test that imports the module should also include
+// gtest-regular-macros.h, to use EXPECT_REGULAR and the other macro's:
+//
+//   import gtest_regular;
+//   #include "gtest-regular-macros.h"
+//
+// Requires a C++20 compiler with module support. gtest-regular.cc must still be
+// linked into the test program.
+
+module;
+
+#include "gtest-regular.h"
+
+export module gtest_regular;
+
+export namespace example_implementation_by_niels_dekker {
+
+// The public types.
+using example_implementation_by_niels_dekker::AllocationCount;
+using example_implementation_by_niels_dekker::AllocationCounter;
+using example_implementation_by_niels_dekker::CheckTimingRecorder;
+using example_implementation_by_niels_dekker::OperationCount;
+using example_implementation_by_niels_dekker::OperationCounter;
+using example_implementation_by_niels_dekker::OperationCountingWrapper;
+using example_implementation_by_niels_dekker::RegularTypeCheckListener;
+using example_implementation_by_niels_dekker::RegularTypeChecker;
+
+// The functions called by the macro's of gtest-regular-macros.h.
+using example_implementation_by_niels_dekker::CheckRegularRange;
+using example_implementation_by_niels_dekker::CheckRegularType;
+using example_implementation_by_niels_dekker::
+    CheckRegularTypeCountingOperations;
+using example_implementation_by_niels_dekker::CheckRegularTypeInParallel;
+using example_implementation_by_niels_dekker::CheckRegularTypeSwappable;
+using example_implementation_by_niels_dekker::CheckRegularTypeWithFastSwap;
+using example_implementation_by_niels_dekker::CheckRegularTypeWithMemoryProfile;
+using example_implementation_by_niels_dekker::CheckRegularTypeWithNothrowMove;
+using example_implementation_by_niels_dekker::
+    CheckRegularTypeWithoutAllocation;
+using example_implementation_by_niels_dekker::CheckRegularTypeWithoutLeaks;
+using example_implementation_by_niels_dekker::CheckTriviallyRelocatableType;
+
+}  // namespace example_implementation_by_niels_dekker
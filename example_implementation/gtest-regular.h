@@ -30,389 +30,1134 @@
 //
 //
 // This header file defines the macro's EXPECT_REGULAR(example_value1,
-// example_value2) and ASSERT_REGULAR(example_value1, example_value2).
+// example_value2) and ASSERT_REGULAR(example_value1, example_value2), as well
+// as EXPECT_REGULAR_RANGE(examples), ASSERT_REGULAR_RANGE(examples),
+// EXPECT_REGULAR_NOALLOC(example_value1, example_value2),
+// ASSERT_REGULAR_NOALLOC(example_value1, example_value2),
+// EXPECT_REGULAR_NOTHROW_MOVE(example_value1, example_value2),
+// ASSERT_REGULAR_NOTHROW_MOVE(example_value1, example_value2),
+// EXPECT_REGULAR_PARALLEL(example_value1, example_value2),
+// ASSERT_REGULAR_PARALLEL(example_value1, example_value2),
+// EXPECT_REGULAR_COUNTED(example_value1, example_value2),
+// ASSERT_REGULAR_COUNTED(example_value1, example_value2),
+// EXPECT_REGULAR_MEMORY_PROFILE(example_value1, example_value2),
+// ASSERT_REGULAR_MEMORY_PROFILE(example_value1, example_value2),
+// EXPECT_REGULAR_NO_LEAK(example_value1, example_value2),
+// ASSERT_REGULAR_NO_LEAK(example_value1, example_value2),
+// EXPECT_REGULAR_SWAPPABLE(example_value1, example_value2),
+// ASSERT_REGULAR_SWAPPABLE(example_value1, example_value2),
+// EXPECT_REGULAR_FAST_SWAP(example_value1, example_value2),
+// ASSERT_REGULAR_FAST_SWAP(example_value1, example_value2),
+// EXPECT_TRIVIALLY_RELOCATABLE(example_value1, example_value2) and
+// ASSERT_TRIVIALLY_RELOCATABLE(example_value1, example_value2).
+//
+// The checks are implemented by the non-template class RegularTypeChecker,
+// which is compiled only once, in gtest-regular.cc. It accesses the values of
+// the type to be checked by type-erased operations, the per-type "thunks" of
+// RegularTypeThunks<T>. gtest-regular.cc must be linked into the test program.
+//
+// The individual checks can be timed by installing a listener, for example a
+// CheckTimingRecorder, by RegularTypeChecker::SetListener(listener). The
+// recorder publishes the durations as test properties, which appear in the XML
+// and JSON output of GoogleTest.
+//
+// RegularTypeChecker::SetTrivialityReportEnabled(true) lets EXPECT_REGULAR
+// report whether a type that passes is trivially copyable, trivially
+// destructible and trivially default constructible, and advise when its
+// hand-written copy and move operations could have been defaulted.
 
 #ifndef GTEST_INCLUDE_GTEST_REGULAR_H_
 #define GTEST_INCLUDE_GTEST_REGULAR_H_
 
+#include <chrono>       // For nanoseconds.
+#include <cstddef>      // For max_align_t and size_t.
+#include <cstdint>      // For uint64_t.
+#include <deque>
+#include <functional>   // For function.
+#include <initializer_list>
+#include <iterator>     // For begin.
+#include <new>          // For placement new.
+#include <ostream>      // For ostream.
 #include <string>
-#include <utility>  // For pair and move.
+#include <type_traits>  // For decay and is_trivially_copyable.
+#include <utility>      // For move, pair and swap.
+#include <vector>
 
-#include "gtest/gtest-message.h"             // For Message.
-#include "gtest/gtest-printers.h"            // For PrintToString.
-#include "gtest/gtest-test-part.h"           // For TestPartResult.
-#include "gtest/gtest.h"                     // For AssertHelper.
+#include "gtest/gtest-printers.h"            // For UniversalTersePrint.
 #include "gtest/internal/gtest-type-util.h"  // For GetTypeName.
 
 // TODO Move from "example_implementation_by_niels_dekker" to
 // "testing::internal".
 namespace example_implementation_by_niels_dekker {
 
-// Helper class for the implementation of EXPECT_REGULAR and ASSERT_REGULAR.
+// A cheap snapshot of a value: a 64-bit FNV-1a hash, and either a copy of the
+// bytes of the value (for a small trivially copyable type), or a bounded
+// prefix of the printed representation of the value (for any other type).
+// Taking a digest does not allocate memory, even when the value has a huge
+// printout.
+//
+// Note that a digest of a type that is not trivially copyable is taken from
+// its printout, so the value is still printed (streamed into the hash, without
+// being stored) each time a digest is taken. Such a digest only reflects what
+// is printed: GoogleTest prints only the first 32 elements of a container, so
+// a modification of a later element does not change the digest.
 //
 // INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+class ValueDigest {
+ public:
+  enum { kMaxPrefixLength = 256 };
+
+  // Takes the digest from the object representation (the bytes) of a
+  // trivially copyable object. Such bytes only change when the object is
+  // modified, so the object does not need to be printed. Keeps a copy of the
+  // bytes, when the object is not larger than kMaxPrefixLength bytes.
+  static ValueDigest FromObjectRepresentation(const void* object,
+                                              std::size_t size);
+
+  // Takes the digest from the printout of a value, produced by the specified
+  // print function.
+  static ValueDigest FromPrintout(void (*print)(const void*, std::ostream*),
+                                  const void* value);
+
+  bool operator==(const ValueDigest& other) const {
+    return hash_ == other.hash_ && length_ == other.length_;
+  }
+
+  bool operator!=(const ValueDigest& other) const { return !(*this == other); }
+
+  // Returns the recorded prefix of the printout (empty when the digest was
+  // taken from the bytes of a trivially copyable object).
+  std::string GetPrefix() const {
+    return has_object_representation_
+               ? std::string()
+               : std::string(reinterpret_cast<const char*>(buffer_),
+                             prefix_length_);
+  }
+
+  // Tells whether the recorded prefix is the entire printout of the value.
+  bool IsPrefixComplete() const { return prefix_length_ == length_; }
+
+  // Returns the copy of the bytes of a trivially copyable object, aligned as
+  // std::max_align_t, or null when the bytes were not kept.
+  const void* GetObjectRepresentation() const {
+    return has_object_representation_ ? buffer_ : nullptr;
+  }
+
+ private:
+  class StreamBuf;
+
+  void Append(const char* data, std::size_t size, bool is_printout);
 
+  std::uint64_t hash_{14695981039346656037u};
+  std::size_t length_{0};
+  std::size_t prefix_length_{0};
+  bool has_object_representation_{false};
+
+  // Either the prefix of the printout, or a copy of the object representation.
+  alignas(std::max_align_t) unsigned char buffer_[kMaxPrefixLength];
+};
+
+// The number of memory allocations, their total size in bytes, and the number
+// of deallocations, and their total size in bytes.
+struct AllocationCount {
+  std::size_t allocations;
+  std::size_t bytes;
+  std::size_t deallocations;
+  std::size_t deallocated_bytes;
+};
+
+// Counts the memory allocations and deallocations of each thread. The counting
+// is done by the replacement operator new and operator delete functions from
+// gtest-regular-new-delete.cc, which must be linked into the test program in
+// order to support EXPECT_REGULAR_NOALLOC, EXPECT_REGULAR_MEMORY_PROFILE and
+// EXPECT_REGULAR_NO_LEAK.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+class AllocationCounter {
+ public:
+  // Starts counting the allocations of the current thread.
+  AllocationCounter() : start_(GetThreadAllocationCount()) {}
+
+  // Returns the allocations of the current thread since construction.
+  AllocationCount GetCount() const {
+    const AllocationCount current = GetThreadAllocationCount();
+    return {current.allocations - start_.allocations,
+            current.bytes - start_.bytes,
+            current.deallocations - start_.deallocations,
+            current.deallocated_bytes - start_.deallocated_bytes};
+  }
+
+  // Called by the replacement operator new functions.
+  static void OnAllocation(const std::size_t size) noexcept {
+    AllocationCount& count = GetThreadAllocationCount();
+    ++count.allocations;
+    count.bytes += size;
+  }
+
+  // Called by the replacement operator delete functions, for a non-null
+  // pointer.
+  static void OnDeallocation(const std::size_t size) noexcept {
+    AllocationCount& count = GetThreadAllocationCount();
+    ++count.deallocations;
+    count.deallocated_bytes += size;
+  }
+
+  // Called once, when the replacement operator new functions are linked in.
+  static void Install() noexcept { IsInstalledFlag() = true; }
+
+  static bool IsInstalled() { return IsInstalledFlag(); }
+
+ private:
+  AllocationCount start_;
+
+  static AllocationCount& GetThreadAllocationCount() noexcept {
+    static thread_local AllocationCount count{};
+    return count;
+  }
+
+  static bool& IsInstalledFlag() noexcept {
+    static bool is_installed{};
+    return is_installed;
+  }
+};
+
+// Type-erased operations on objects of a specific type, used by
+// RegularTypeChecker. The function pointers refer to the thunks of
+// RegularTypeThunks<T>.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+struct RegularTypeOperations {
+  std::size_t size;
+  std::size_t alignment;
+  bool is_trivially_copyable;
+  bool is_trivially_destructible;
+  bool is_trivially_default_constructible;
+  bool is_nothrow_move_constructible;
+  bool is_nothrow_move_assignable;
+  bool is_nothrow_swappable;
+  bool has_custom_swap;  // Whether argument-dependent lookup finds a swap.
+  void (*value_initialize)(void* target);
+  void (*copy_construct)(void* target, const void* source);
+  void (*move_construct)(void* target, void* source);
+  void (*destruct)(void* object);
+  void (*copy_assign)(void* target, const void* source);
+  void (*move_assign)(void* target, void* source);
+  void (*swap)(void* object1, void* object2);  // Null, unless requested.
+
+  // Swaps by three moves, like the generic std::swap. Null, unless requested.
+  void (*generic_swap)(void* object1, void* object2);
+  bool (*equal)(const void* left_operand, const void* right_operand);
+  bool (*unequal)(const void* left_operand, const void* right_operand);
+  void (*print)(const void* value, std::ostream* os);
+
+  // Grows an std::vector of copies of the example, and returns the number of
+  // copies made by its reallocations. Null, unless requested.
+  std::size_t (*count_vector_reallocation_copies)(const void* example);
+};
+
+// The number of calls of each of the special member functions, the swap, and
+// the comparison operators of a type.
+struct OperationCount {
+  std::size_t value_initializations;
+  std::size_t copy_constructions;
+  std::size_t move_constructions;
+  std::size_t copy_assignments;
+  std::size_t move_assignments;
+  std::size_t swaps;
+  std::size_t destructions;
+  std::size_t equality_comparisons;
+  std::size_t inequality_comparisons;
+
+  // Returns the non-zero counts, like "copy-constructions: 1, destructions: 1",
+  // or "none".
+  std::string ToString() const;
+};
+
+// Counts the operations on OperationCountingWrapper objects that are done by
+// the current thread, since the construction of the counter. Allows checking
+// the number of operations done by user code. For example:
+//
+//   std::vector<OperationCountingWrapper<T>> wrappers = ...;
+//   const OperationCounter counter;
+//   FunctionUnderTest(wrappers);
+//   EXPECT_LE(counter.GetCount().copy_constructions, 1);
+class OperationCounter {
+ public:
+  OperationCounter() : start_(GetThreadOperationCount()) {}
+
+  // Returns the operations of the current thread since construction.
+  OperationCount GetCount() const;
+
+  // Called by OperationCountingWrapper.
+  static void OnOperation(
+      std::size_t OperationCount::*const operation) noexcept {
+    ++(GetThreadOperationCount().*operation);
+  }
+
+ private:
+  OperationCount start_;
+
+  static OperationCount& GetThreadOperationCount() noexcept {
+    static thread_local OperationCount count{};
+    return count;
+  }
+};
+
+// Wraps a value, and counts its operations, by means of OperationCounter. The
+// construction of a wrapper from a value of type T is not counted. Its
+// move-constructor and move-assignment are noexcept if and only if the ones of
+// T are noexcept, so that for example std::vector<OperationCountingWrapper<T>>
+// chooses between moving and copying in the same way as std::vector<T>.
 template <typename T>
-class RegularTypeChecker {
+class OperationCountingWrapper {
  public:
-  class Example {
-   public:
-    Example(const T& value, const char* const expression)
-        : value_(value),
-          value_as_string_(::testing::PrintToString(value)),
-          expression_(expression) {
-      // Note: the string representation of the value (value_as_string_) is
-      // generated at construction time, in order to be ahead of any possibly
-      // changes of value_ during the test.
-    }
+  OperationCountingWrapper() : value_() {
+    OperationCounter::OnOperation(&OperationCount::value_initializations);
+  }
 
-    const T& GetValue() const { return value_; }
-    const char* GetExpression() const { return expression_; }
+  explicit OperationCountingWrapper(const T& value) : value_(value) {}
+  explicit OperationCountingWrapper(T&& value) : value_(std::move(value)) {}
 
-    std::string ToString() const {
-      std::string result(expression_);
+  OperationCountingWrapper(const OperationCountingWrapper& other)
+      : value_(other.value_) {
+    OperationCounter::OnOperation(&OperationCount::copy_constructions);
+  }
 
-      if (value_as_string_ != expression_) {
-        result.append("\n    Which is: ").append(value_as_string_);
-      }
-      return result;
-    }
+  OperationCountingWrapper(OperationCountingWrapper&& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : value_(std::move(other.value_)) {
+    OperationCounter::OnOperation(&OperationCount::move_constructions);
+  }
 
-   private:
-    const T& value_;
-    const std::string value_as_string_;
-    const char* const expression_;
-  };
+  OperationCountingWrapper& operator=(const OperationCountingWrapper& other) {
+    value_ = other.value_;
+    OperationCounter::OnOperation(&OperationCount::copy_assignments);
+    return *this;
+  }
+
+  OperationCountingWrapper& operator=(
+      OperationCountingWrapper&& other) noexcept(
+      std::is_nothrow_move_assignable<T>::value) {
+    value_ = std::move(other.value_);
+    OperationCounter::OnOperation(&OperationCount::move_assignments);
+    return *this;
+  }
 
-  RegularTypeChecker(const T& example_value1,
-                     const char* const example_expression1,
-                     const T& example_value2,
-                     const char* const example_expression2,
-                     std::string& message)
-      : examples_{Example(example_value1, example_expression1),
-                  Example(example_value2, example_expression2)},
-        message_(message) {}
-
-  bool Check() const {
-    return CheckEqualToSelf<0>() && CheckEqualToSelf<1>() &&
-           CheckUnequal<0>() && CheckUnequal<1>() &&
-           CheckValueInitialization() && CheckCopyAndMoveConstruct<0>() &&
-           CheckCopyAndMoveConstruct<1>() &&
-           CheckAssigningDifferentValue<0>() &&
-           CheckAssigningDifferentValue<1>() &&
-           CheckAssigningItsOriginalValue<0>() &&
-           CheckAssigningItsOriginalValue<1>() && CheckSelfAssignment<0>() &&
-           CheckSelfAssignment<1>() && CheckCopyValue<0>() &&
-           CheckCopyValue<1>();
+  ~OperationCountingWrapper() {
+    OperationCounter::OnOperation(&OperationCount::destructions);
+  }
+
+  const T& GetValue() const { return value_; }
+
+  friend void swap(OperationCountingWrapper& left,
+                   OperationCountingWrapper& right) {
+    using std::swap;
+    swap(left.value_, right.value_);
+    OperationCounter::OnOperation(&OperationCount::swaps);
+  }
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+  friend bool operator==(const OperationCountingWrapper& left,
+                         const OperationCountingWrapper& right) {
+    OperationCounter::OnOperation(&OperationCount::equality_comparisons);
+    return left.value_ == right.value_;
+  }
+
+  friend bool operator!=(const OperationCountingWrapper& left,
+                         const OperationCountingWrapper& right) {
+    OperationCounter::OnOperation(&OperationCount::inequality_comparisons);
+    return left.value_ != right.value_;
+  }
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+  friend void PrintTo(const OperationCountingWrapper& wrapper,
+                      std::ostream* const os) {
+    ::testing::internal::UniversalTersePrint(wrapper.value_, os);
   }
 
  private:
-  std::pair<Example, Example> examples_;  // Two different example values of T.
-  std::string& message_;
+  T value_;
+};
+
+namespace swap_detection {
+
+// A deleted swap that accepts any type. Unqualified lookup of swap within this
+// namespace only finds this one, so that a call to swap only compiles when
+// argument-dependent lookup finds a better match: a custom swap for the type.
+template <typename T>
+void swap(T&, T&) = delete;
+
+// Tells whether argument-dependent lookup finds a swap for type T (other than
+// the generic std::swap), like a "hidden friend" swap, or a swap in the
+// namespace of T.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T, typename = void>
+struct HasCustomSwap : std::false_type {};
+
+template <typename T>
+struct HasCustomSwap<T, decltype(static_cast<void>(swap(
+                            std::declval<T&>(), std::declval<T&>())))>
+    : std::true_type {};
+
+}  // namespace swap_detection
+
+// The thunks that implement the operations of RegularTypeOperations for a
+// specific type T. This is the only part of the checks that is instantiated
+// for each type.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T>
+class RegularTypeThunks {
+ public:
+  // Returns the operations, except for the swaps, which are only instantiated
+  // by GetOperationsIncludingSwap(), as std::swap does not support types with
+  // an explicit move-constructor, and except for the growth of an std::vector,
+  // which is only instantiated by GetOperationsIncludingVectorGrowth().
+  static const RegularTypeOperations& GetOperations() {
+    static const RegularTypeOperations operations =
+        MakeOperations(nullptr, nullptr, nullptr);
+    return operations;
+  }
+
+  static const RegularTypeOperations& GetOperationsIncludingSwap() {
+    static const RegularTypeOperations operations =
+        MakeOperations(&Swap, &GenericSwap, nullptr);
+    return operations;
+  }
+
+  static const RegularTypeOperations& GetOperationsIncludingVectorGrowth() {
+    static const RegularTypeOperations operations =
+        MakeOperations(nullptr, nullptr, &CountVectorReallocationCopies);
+    return operations;
+  }
+
+ private:
+  static RegularTypeOperations MakeOperations(
+      void (*const swap)(void*, void*),
+      void (*const generic_swap)(void*, void*),
+      std::size_t (*const count_vector_reallocation_copies)(const void*)) {
+    return {sizeof(T),
+            alignof(T),
+            std::is_trivially_copyable<T>::value,
+            std::is_trivially_destructible<T>::value,
+            std::is_trivially_default_constructible<T>::value,
+            std::is_nothrow_move_constructible<T>::value,
+            std::is_nothrow_move_assignable<T>::value,
+            IsNothrowSwappable(),
+            swap_detection::HasCustomSwap<T>::value,
+            &ValueInitialize,
+            &CopyConstruct,
+            &MoveConstruct,
+            &Destruct,
+            &CopyAssign,
+            &MoveAssign,
+            swap,
+            generic_swap,
+            &Equal,
+            &Unequal,
+            &Print,
+            count_vector_reallocation_copies};
+  }
+
+  // Equivalent to C++17 std::is_nothrow_swappable<T>::value.
+  static constexpr bool IsNothrowSwappable() {
+    using std::swap;
+    return noexcept(swap(std::declval<T&>(), std::declval<T&>()));
+  }
+
+  static const T& Cast(const void* const object) {
+    return *static_cast<const T*>(object);
+  }
+
+  static T& Cast(void* const object) { return *static_cast<T*>(object); }
+
+  static void ValueInitialize(void* const target) { ::new (target) T(); }
+
+  static void CopyConstruct(void* const target, const void* const source) {
+    ::new (target) T(Cast(source));
+  }
+
+  static void MoveConstruct(void* const target, void* const source) {
+    ::new (target) T(std::move(Cast(source)));
+  }
+
+  static void Destruct(void* const object) { Cast(object).~T(); }
+
+  static void CopyAssign(void* const target, const void* const source) {
+    Cast(target) = Cast(source);
+  }
+
+  static void MoveAssign(void* const target, void* const source) {
+    Cast(target) = std::move(Cast(source));
+  }
+
+  static void Swap(void* const object1, void* const object2) {
+    using std::swap;
+    swap(Cast(object1), Cast(object2));
+  }
+
+  static void GenericSwap(void* const object1, void* const object2) {
+    T temporary(std::move(Cast(object1)));
+    Cast(object1) = std::move(Cast(object2));
+    Cast(object2) = std::move(temporary);
+  }
 
 #ifdef __GNUC__
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wfloat-equal"
 #endif
 
-  // Equal(const T&, const T&) and Unequal(const T&, const T&) are meant to
-  // avoid compile warnings that might occur when using `==` and `!=` directly,
-  // like:
-  // - "self-comparison always evaluates to true [-Wtautological-compare]"
-  // - "comparing floating point with == or != is unsafe [-Wfloat-equal]"
+  // Equal and Unequal are meant to avoid compile warnings that might occur
+  // when using `==` and `!=` directly, like "comparing floating point with ==
+  // or != is unsafe [-Wfloat-equal]"
 
-  static bool Equal(const T& left_operand, const T& right_operand) {
-    return left_operand == right_operand;
+  static bool Equal(const void* const left_operand,
+                    const void* const right_operand) {
+    return Cast(left_operand) == Cast(right_operand);
   }
 
-  static bool Unequal(const T& left_operand, const T& right_operand) {
-    return left_operand != right_operand;
+  static bool Unequal(const void* const left_operand,
+                      const void* const right_operand) {
+    return Cast(left_operand) != Cast(right_operand);
   }
 
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif
 
-  template <unsigned example_index>
-  const Example& GetExample() const {
-    return std::get<example_index>(examples_);
+  static void Print(const void* const value, std::ostream* const os) {
+    ::testing::internal::UniversalTersePrint(Cast(value), os);
   }
 
-  template <unsigned example_index>
-  const T& GetExampleValue() const {
-    return GetExample<example_index>().GetValue();
+  static std::size_t CountVectorReallocationCopies(const void* const example) {
+    enum { kNumberOfElements = 100 };
+    const OperationCounter counter;
+    std::vector<OperationCountingWrapper<T>> elements;
+
+    for (int i{}; i < kNumberOfElements; ++i) {
+      // Note: emplace_back constructs the new element from Cast(example),
+      // without calling the copy-constructor of the wrapper, so only the
+      // copies made by reallocations are counted.
+      elements.emplace_back(Cast(example));
+    }
+    return counter.GetCount().copy_constructions;
   }
+};
+
+// Observes the checks done by RegularTypeChecker::Check(), in order to time
+// them. Installed by RegularTypeChecker::SetListener(listener). When no
+// listener is installed (the default), the checks are not timed at all.
+class RegularTypeCheckListener {
+ public:
+  virtual ~RegularTypeCheckListener() = default;
 
-  template <unsigned example_index>
-  bool CheckEqualToExample(const T& value,
-                           const std::string& short_message) const {
-    const Example& example = GetExample<example_index>();
+  // Called after each check, with the name of the check (like
+  // "CheckCopyValue", or "TakeDigest" for the digest of an example value) and
+  // its duration.
+  virtual void OnCheckTimed(const char* check_name,
+                            std::chrono::nanoseconds duration) = 0;
+};
 
-    if (Unequal(value, example.GetValue())) {
-      message_.append(short_message)
-          .append("\n    Actual value: ")
-          .append(::testing::PrintToString(value))
-          .append("\n    Compares unequal to: ")
-          .append(example.ToString());
-      return false;
-    }
-    return true;
-  }
-
-  bool CheckValueInitialization() const {
-    const T& value_initialized1 = T();
-    const T& value_initialized2 = T();
-    if (Unequal(value_initialized1, value_initialized2)) {
-      using namespace ::testing;
-      message_
-          .append(
-              "Value-initialization should always yield the same value"
-              "\n    Value-initialized object 1: ")
-          .append(PrintToString(value_initialized1))
-          .append("\n    Value-initialized object 2: ")
-          .append(PrintToString(value_initialized2));
-
-      return false;
-    }
-    return true;
+// Adds up the durations of the checks of each test, per check, and records
+// them (in nanoseconds) as properties of the test, named "timing.<check name>".
+// The properties appear in the XML and JSON output of GoogleTest. Usage:
+//
+//   CheckTimingRecorder recorder;
+//   RegularTypeChecker::SetListener(&recorder);
+class CheckTimingRecorder : public RegularTypeCheckListener {
+ public:
+  void OnCheckTimed(const char* check_name,
+                    std::chrono::nanoseconds duration) override;
+
+ private:
+  const void* test_info_{};  // The test of the recorded durations.
+  std::vector<std::pair<std::string, std::chrono::nanoseconds>> durations_;
+};
+
+// An example value, accessed by a type-erased pointer, together with its
+// expression in the source code, and a digest of its original value.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+class RegularTypeExample {
+ public:
+  RegularTypeExample(const RegularTypeOperations& operations, const void* value,
+                     std::string expression);
+
+  const void* GetValue() const { return value_; }
+  const std::string& GetExpression() const { return expression_; }
+
+  // Returns an example of a copy of the value of this example, having the
+  // same expression and the same digest, so that no new digest needs to be
+  // taken.
+  RegularTypeExample WithCopiedValue(const void* const copied_value) const {
+    RegularTypeExample result(*this);
+    result.value_ = copied_value;
+    return result;
   }
 
-  template <unsigned example_index>
-  bool CheckEqualToSelf() const {
-    const Example& example = GetExample<example_index>();
+  // Takes a new digest of the value, to be called after a deliberate
+  // modification of the value.
+  void UpdateDigest();
 
-    const T& value = example.GetValue();
+  // Tells whether the value was modified after the construction of this
+  // example (or the last UpdateDigest() call), by comparing its digest with
+  // the original one. Only detects modifications that change the digest (see
+  // ValueDigest).
+  bool IsModified() const;
 
-    if (Equal(value, value)) {
-      if (!Unequal(value, value)) {
-        return true;
-      }
-      message_.append("Object should not compare unequal to itself!");
-    } else {
-      message_.append("Object should compare equal to itself!");
-    }
-    message_.append("\n    Value: ").append(example.ToString());
-    return false;
-  }
-
-  template <unsigned example_index>
-  bool CheckUnequal() const {
-    const Example& left_example = GetExample<example_index>();
-    const Example& right_example = GetExample<1 - example_index>();
-    const T& left_operand = left_example.GetValue();
-    const T& right_operand = right_example.GetValue();
-
-    if (Equal(left_operand, right_operand)) {
-      message_.append("The two examples should not compare equal!");
-    } else {
-      if (Unequal(left_operand, right_operand)) {
-        return true;
-      }
-      message_.append("The two examples should compare unequal!");
-    }
+  // Returns the expression, followed by the printout of the value, and a note
+  // when the value was modified after the construction of this example,
+  // followed by (the start of) its original value, when available.
+  std::string ToString() const;
 
-    message_.append("\n    Left operand: ")
-        .append(left_example.ToString())
-        .append("\n    Right operand: ")
-        .append(right_example.ToString());
-    return false;
-  }
-
-  template <unsigned example_index>
-  bool CheckCopyAndMoveConstruct() const {
-    const T& example_value = GetExampleValue<example_index>();
-    const T copied_value(example_value);
-
-    if (CheckEqualToExample<example_index>(
-            copied_value,
-            "A copy-constructed object must have a value equal to the "
-            "original.")) {
-      T non_const_lvalue(example_value);
-      const T moved_value(std::move(non_const_lvalue));
-      if (CheckEqualToExample<example_index>(
-              moved_value,
-              "A move-constructed object must have a value equal to the "
-              "original.")) {
-        non_const_lvalue = GetExampleValue<1 - example_index>();
-
-        return CheckEqualToExample<1 - example_index>(
-            non_const_lvalue,
-            "The target of a copy-assignment must get a value equal to the "
-            "source, even when the target object was previously moved-from (as "
-            "source of a move-construction).");
-      }
-    }
-    return false;
-  }
-
-  template <unsigned example_index>
-  bool CheckAssigningDifferentValue() const {
-    const T& initial_target_value = GetExampleValue<1 - example_index>();
-    const T const_source(GetExampleValue<example_index>());
-    T copy_assign_target(initial_target_value);
-    copy_assign_target = const_source;
-    if (CheckEqualToExample<example_index>(
-            copy_assign_target,
-            "A copy-assigned-to object must have a value equal to the "
-            "source object.")) {
-      if (CheckEqualToExample<example_index>(
-              const_source,
-              "The source object of a copy-assignment must preserve its "
-              "value.")) {
-        T move_assign_target(initial_target_value);
-
-        T non_const_source(const_source);
-        move_assign_target = std::move(non_const_source);
-
-        return CheckEqualToExample<example_index>(
-            move_assign_target,
-            "The value of a move-assigned-to object must be equal to the "
-            "original value of the source object.");
-      }
-    }
-    return false;
-  }
-
-  template <unsigned example_index>
-  bool CheckCopyValue() const {
-    const T& source = GetExampleValue<example_index>();
-
-    // Workaround for GCC warning: variable set but not used
-    // [-Werror=unused-but-set-variable]
-    const auto DoNotUse = [](const T&) {};
-
-    if (Unequal(source, T())) {
-      T copy_construct_target(source);
-      DoNotUse(copy_construct_target);
-      copy_construct_target = T();
-      DoNotUse(copy_construct_target);
-
-      if (Equal(source, T())) {
-        message_ +=
-            "Assigning T() to a copy-constructed object should not "
-            "affect the source of the copy-construction.";
-        return false;
-      }
-      T assign_target;
-      assign_target = source;
-      DoNotUse(assign_target);
-      assign_target = T();
-      DoNotUse(assign_target);
-
-      if (Equal(source, T())) {
-        message_ +=
-            "Assigning T() to a copy-assigned-to object should not "
-            "affect the source of the previous assignment.";
-        return false;
-      }
-    }
-    T target(source);
-    DoNotUse(target);
-
-    const T& other_source = GetExampleValue<1 - example_index>();
-    target = other_source;
-    DoNotUse(target);
-
-    if (Equal(source, other_source)) {
-      message_ +=
-          "Assigning a new value to a copy-constructed-to object should not "
-          "affect the source of the copy-construction.";
-      return false;
-    }
+ private:
+  const RegularTypeOperations* operations_;
+  const void* value_;
+  ValueDigest digest_;
+  std::string expression_;
+};
 
-    return true;
+// Helper class for the implementation of EXPECT_REGULAR and ASSERT_REGULAR.
+// Type-erased: the message building and control flow of the checks are only
+// compiled once, in gtest-regular.cc.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+class RegularTypeChecker {
+ public:
+  // Constructs a checker for two different example values.
+  RegularTypeChecker(const RegularTypeOperations& operations,
+                     const void* example_value1,
+                     const char* example_expression1,
+                     const void* example_value2,
+                     const char* example_expression2, std::string& message);
+
+  // Constructs a checker for an arbitrary number of examples, which should
+  // all have different values.
+  RegularTypeChecker(const RegularTypeOperations& operations,
+                     std::vector<RegularTypeExample> examples,
+                     std::string& message);
+
+  // Runs the checks that involve a single example once per example, and the
+  // checks that involve two examples once for each ordered pair of examples.
+  // With two examples, the checks are done in the following order:
+  // CheckEqualToSelf(0), CheckEqualToSelf(1), CheckUnequal(0, 1),
+  // CheckUnequal(1, 0), CheckValueInitialization(), etc.
+  bool Check() const;
+
+  // Does the same checks as Check(), but runs them on the specified number of
+  // threads (or on as many threads as the hardware supports, when the number
+  // is zero). Each check works on its own copies of the examples, which are
+  // copy-constructed before any thread is started. (When a copy does not
+  // compare equal to its example, the checks are done sequentially instead, by
+  // Check().) When checks fail, their messages are merged in the order in which
+  // Check() does the checks, so that the first message is the one that Check()
+  // would produce. An exception thrown by a check is reported as the failure
+  // message of that check.
+  bool CheckInParallel(unsigned thread_count) const;
+
+  // Returns the examples of the checker, so that other checks of the same
+  // examples can reuse them, including their digests.
+  const std::vector<RegularTypeExample>& GetExamples() const noexcept {
+    return examples_;
   }
 
-  template <unsigned example_index>
-  bool CheckSelfAssignment() const {
-    const Example& example = GetExample<example_index>();
+  // Updates the digests of the examples, after the example values have been
+  // replaced by new values. Allows reusing the checker for many values.
+  void UpdateExampleDigests();
 
-    T value(example.GetValue());
+  // Checks that move-construction, move-assignment, value-initialization and
+  // swap do not allocate memory.
+  bool CheckNoAllocation() const;
 
-    // Note that a simple `value = value` statement might cause a compile
-    // warning ("explicitly assigning value of variable of type 'T' to itself
-    // [-Wself-assign-overloaded]"), which appears avoided by using `const_ref`.
-    const T& const_ref = value;
-    value = const_ref;
+  // Checks that move-construction, move-assignment and swap are noexcept, and
+  // that the reallocations of an std::vector move its elements, rather than
+  // copying them.
+  bool CheckNothrowMove() const;
 
-    if (CheckEqualToExample<example_index>(
-            value,
-            "A self-assigned object must have the same value as before.")) {
-      value = std::move(value);
+  // Checks that swapping two examples exchanges their values, that swapping
+  // with a moved-from object, and swapping an object with itself, keep the
+  // values correct, and that swap is noexcept and does not allocate memory.
+  bool CheckSwap() const;
 
-      if (Equal(value, value)) {
-        value = GetExampleValue<1 - example_index>();
+  // Measures the duration of a swap of the first two examples, by the custom
+  // swap of the type (if any), and by the generic swap, by three moves, and
+  // records them, and their ratio, as a property of the current test, named
+  // "swap.<type name>". Only reports the durations: it does not fail.
+  void RecordSwapSpeed(const std::string& type_name) const;
 
-        return CheckEqualToExample<1 - example_index>(
-            value,
-            "When an object is first self-move-assigned and then copy-assigned "
-            "to, its value must compare equal to the source of the "
-            "copy-assignment.");
-      }
-      message_
-          .append(
-              "A self-move-assigned object must (still) be equal to itself.")
-          .append("\n    Failed for: ")
-          .append(example.ToString());
-    }
-    return false;
-  }
-
-  template <unsigned example_index>
-  bool CheckAssigningItsOriginalValue() const {
-    const T& example_value = GetExampleValue<example_index>();
-    T value(example_value);
-    value = example_value;
-    if (CheckEqualToExample<example_index>(
-            value,
-            "The value of an object must be equal to its original value, when "
-            "it is copy-assigned the same value.")) {
-      T same_value(example_value);
-      value = std::move(same_value);
-
-      return CheckEqualToExample<example_index>(
-          value,
-          "The value of an object must be equal to its original value, when it "
-          "is move-assigned the same value.");
-    }
-    return false;
+  // Does the same as RecordSwapSpeed(type_name), and checks that the custom
+  // swap is not much slower than the generic swap. Note that this verdict
+  // depends on time measurements, so it may be affected by the load of the
+  // machine.
+  bool CheckSwapSpeed(const std::string& type_name) const;
+
+  // Checks that each example survives a bitwise relocation (by memcpy, without
+  // calling the destructor of the source): the relocated object should compare
+  // equal to the example, and should still be copyable and assignable. Records
+  // the result as a property of the current test, named
+  // "trivially_relocatable.<type name>".
+  bool CheckTriviallyRelocatable(const std::string& type_name) const;
+
+  // Records whether the type is trivially copyable, trivially destructible and
+  // trivially default constructible, as a property of the current test, named
+  // "triviality.<type name>". When the type is not trivially copyable, while
+  // it is trivially destructible, and its copy and move operations yield
+  // bytewise identical copies of the examples, it also records the advisory
+  // that the type could be trivially copyable, as "triviality_advisory.<type
+  // name>".
+  void RecordTrivialityReport(const std::string& type_name) const;
+
+  // Records whether move-construction, move-assignment and swap are noexcept,
+  // as a property of the current test, named "noexcept.<type name>". Only
+  // EXPECT_REGULAR_NOTHROW_MOVE records this property.
+  void RecordNoexceptProperty(const std::string& type_name) const;
+
+  // Does the same checks as Check(), while counting the bytes allocated and
+  // deallocated by each check, and checks that each check deallocates all the
+  // memory that it allocates.
+  bool CheckWithoutLeaks() const;
+
+  // Records the memory allocated by value-initialization, and by the
+  // copy-construction, copy-assignment and move-construction of each example,
+  // and the memory deallocated by its destruction, as properties of the
+  // current test, named "memory.value_initialization" and "memory.<example
+  // expression>".
+  bool RecordMemoryProfile() const;
+
+  // Does the same checks as Check(), while counting the operations of each
+  // check by an OperationCounter, and records the counts as properties of the
+  // current test, named "operations.<check name>". Meant for examples of type
+  // OperationCountingWrapper<T>.
+  bool CheckCountingOperations() const;
+
+  // Installs the listener that times the checks done by Check(), or uninstalls
+  // it, when the argument is null. Checks run by CheckInParallel() are not
+  // timed.
+  static void SetListener(RegularTypeCheckListener* const listener) noexcept {
+    ListenerPointer() = listener;
   }
+
+  static RegularTypeCheckListener* GetListener() noexcept {
+    return ListenerPointer();
+  }
+
+  // Enables or disables the triviality report (RecordTrivialityReport) by
+  // EXPECT_REGULAR, ASSERT_REGULAR, their RANGE variants, and
+  // REGULAR_TYPED_TEST_SUITE, for the types that pass their checks. Disabled
+  // by default.
+  static void SetTrivialityReportEnabled(const bool is_enabled) noexcept {
+    TrivialityReportFlag() = is_enabled;
+  }
+
+  static bool IsTrivialityReportEnabled() noexcept {
+    return TrivialityReportFlag();
+  }
+
+  // One of the checks done by Check(), for specific examples.
+  struct Task {
+    const char* name;  // The name of the check, like "CheckCopyValue".
+    std::function<bool(const RegularTypeChecker&)> run;
+  };
+
+  // Returns the checks done by Check(), in the order in which Check() does
+  // them. Used by CheckInParallel(), and by the check_overhead benchmark, to
+  // measure the checks one by one. (Check() itself does not need the tasks, so
+  // it avoids their allocations.)
+  std::vector<Task> GetTasks() const;
+
+ private:
+  // A type-erased object, created by the checker.
+  class Object;
+
+  const RegularTypeOperations& operations_;
+  std::vector<RegularTypeExample> examples_;  // At least two different values.
+  std::string& message_;
+
+  static RegularTypeCheckListener*& ListenerPointer() noexcept {
+    static RegularTypeCheckListener* listener{};
+    return listener;
+  }
+
+  static bool& TrivialityReportFlag() noexcept {
+    static bool is_enabled{};
+    return is_enabled;
+  }
+
+  // One of the checks done by Check(). Exactly one of the member function
+  // pointers is non-null: the one that checks either no example, a single
+  // example, or an ordered pair of examples.
+  struct CheckFunction {
+    const char* name;
+    bool (RegularTypeChecker::*check_without_example)() const;
+    bool (RegularTypeChecker::*check_example)(std::size_t) const;
+    bool (RegularTypeChecker::*check_pair_of_examples)(std::size_t,
+                                                       std::size_t) const;
+  };
+
+  // The checks done by Check(), in the order in which Check() does them.
+  static const CheckFunction check_functions[];
+
+  // Returns the number of invocations of the specified check: once, once per
+  // example, or once for each ordered pair of different examples.
+  std::size_t GetInvocationCount(const CheckFunction& check) const;
+
+  // Runs the invocation of the specified check that has the specified index
+  // (less than GetInvocationCount(check)).
+  bool RunCheck(const CheckFunction& check,
+                std::size_t invocation_index) const;
+
+  // Does the same checks as Check(), while notifying the listener.
+  bool CheckWithListener(RegularTypeCheckListener& listener) const;
+
+  bool Equal(const void* left_operand, const void* right_operand) const;
+  bool Unequal(const void* left_operand, const void* right_operand) const;
+  std::string PrintToString(const void* value) const;
+
+  const RegularTypeExample& GetExample(std::size_t example_index) const;
+  const void* GetExampleValue(std::size_t example_index) const;
+  std::size_t GetOtherIndex(std::size_t example_index) const;
+
+  bool ForEachExample(
+      bool (RegularTypeChecker::*check)(std::size_t) const) const;
+  bool ForEachPairOfExamples(
+      bool (RegularTypeChecker::*check)(std::size_t, std::size_t) const) const;
+
+  bool CheckEqualToExample(std::size_t example_index, const void* value,
+                           const char* short_message) const;
+  bool CheckNoAllocationByOperation(const AllocationCounter& counter,
+                                    const char* operation_name,
+                                    std::size_t example_index) const;
+
+  bool CheckValueInitializationWithoutAllocation() const;
+  bool CheckMoveConstructWithoutAllocation(std::size_t example_index) const;
+  bool CheckMoveAssignWithoutAllocation(std::size_t example_index) const;
+  bool CheckSwapWithoutAllocation(std::size_t example_index) const;
+  bool CheckVectorReallocationMoves(std::size_t example_index) const;
+
+  bool CheckSwapExchangingValues(std::size_t example_index,
+                                 std::size_t other_index) const;
+  bool CheckSwapWithMovedFrom(std::size_t example_index) const;
+  bool CheckSelfSwap(std::size_t example_index) const;
+
+  // Measures the durations of a custom swap (if any) and the generic swap, in
+  // nanoseconds, records them, and returns the recorded property value.
+  std::string RecordSwapDurations(const std::string& type_name,
+                                  double& custom_swap_duration,
+                                  double& generic_swap_duration) const;
+  bool CheckBitwiseRelocation(std::size_t example_index) const;
+  bool IsCopyBytewise(std::size_t example_index) const;
+
+  bool CheckValueInitialization() const;
+  bool CheckEqualToSelf(std::size_t example_index) const;
+  bool CheckUnequal(std::size_t left_index, std::size_t right_index) const;
+  bool CheckCopyAndMoveConstruct(std::size_t example_index) const;
+  bool CheckAssigningDifferentValue(std::size_t example_index,
+                                    std::size_t other_index) const;
+  bool CheckCopyValue(std::size_t example_index,
+                      std::size_t other_index) const;
+  bool CheckSelfAssignment(std::size_t example_index) const;
+  bool CheckAssigningItsOriginalValue(std::size_t example_index) const;
 };
 
+// Checks the specified number of examples, stored contiguously, like the
+// elements of an std::vector. Non-template driver of REGULAR_TYPED_TEST_SUITE.
+void CheckRegularExamples(bool is_failure_fatal, const char* file, int line,
+                          const RegularTypeOperations& operations,
+                          const void* examples, std::size_t example_count,
+                          const char* examples_expression,
+                          const std::string& type_name);
+
+// Reports a (fatal or non-fatal) failure, with the specified message.
+void ReportFailure(bool is_failure_fatal, const char* file, int line,
+                   const std::string& message);
+
+// Reports that the type with the specified name is not regular.
+void ReportIrregularType(bool is_failure_fatal, const char* file, int line,
+                         const std::string& type_name,
+                         const std::string& message);
+
 template <bool is_failure_fatal, typename T>
 void CheckRegularType(const char* const file, int line, const T& example_value1,
                       const char* const example_expression1,
                       const T& example_value2,
                       const char* const example_expression2) {
   std::string message;
-  const RegularTypeChecker<T> checker(example_value1, example_expression1,
-                                      example_value2, example_expression2,
-                                      message);
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &example_value1, example_expression1,
+                                   &example_value2, example_expression2,
+                                   message);
   if (!checker.Check()) {
-    using namespace ::testing;
-    constexpr TestPartResult::Type result_type{
-        is_failure_fatal ? TestPartResult::kFatalFailure
-                         : TestPartResult::kNonFatalFailure};
-    // Assign Message() to enable streaming; see AssertHelper::operator=.
-    ::testing::internal::AssertHelper(
-        result_type, file, line,
-        ("Type expected to be regular: '" +
-         testing::internal::GetTypeName<T>() + "'\n  " + message)
-            .c_str()) = Message();
+    ReportIrregularType(is_failure_fatal, file, line,
+                        testing::internal::GetTypeName<T>(), message);
+  } else if (RegularTypeChecker::IsTrivialityReportEnabled()) {
+    checker.RecordTrivialityReport(testing::internal::GetTypeName<T>());
   }
 }
 
-}  // namespace example_implementation_by_niels_dekker
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeWithoutAllocation(const char* const file, int line,
+                                       const T& example_value1,
+                                       const char* const example_expression1,
+                                       const T& example_value2,
+                                       const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(
+      RegularTypeThunks<T>::GetOperationsIncludingSwap(), &example_value1,
+      example_expression1, &example_value2, example_expression2, message);
+  if (!(checker.Check() && checker.CheckNoAllocation())) {
+    ReportIrregularType(is_failure_fatal, file, line,
+                        testing::internal::GetTypeName<T>(), message);
+  }
+}
 
-#define EXPECT_REGULAR(example_value1, example_value2)                     \
-  ::example_implementation_by_niels_dekker::CheckRegularType<false>(       \
-      __FILE__, __LINE__, example_value1, #example_value1, example_value2, \
-      #example_value2)
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeWithoutLeaks(const char* const file, int line,
+                                  const T& example_value1,
+                                  const char* const example_expression1,
+                                  const T& example_value2,
+                                  const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &example_value1, example_expression1,
+                                   &example_value2, example_expression2,
+                                   message);
+  if (!checker.CheckWithoutLeaks()) {
+    ReportIrregularType(is_failure_fatal, file, line,
+                        testing::internal::GetTypeName<T>(), message);
+  }
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeWithMemoryProfile(
+    const char* const file, int line, const T& example_value1,
+    const char* const example_expression1, const T& example_value2,
+    const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &example_value1, example_expression1,
+                                   &example_value2, example_expression2,
+                                   message);
+  if (!(checker.Check() && checker.RecordMemoryProfile())) {
+    ReportIrregularType(is_failure_fatal, file, line,
+                        testing::internal::GetTypeName<T>(), message);
+  }
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeWithNothrowMove(const char* const file, int line,
+                                     const T& example_value1,
+                                     const char* const example_expression1,
+                                     const T& example_value2,
+                                     const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(
+      RegularTypeThunks<T>::GetOperationsIncludingVectorGrowth(),
+      &example_value1, example_expression1, &example_value2,
+      example_expression2, message);
+  const std::string type_name = testing::internal::GetTypeName<T>();
+  checker.RecordNoexceptProperty(type_name);
+
+  if (!(checker.Check() && checker.CheckNothrowMove())) {
+    ReportIrregularType(is_failure_fatal, file, line, type_name, message);
+  }
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeSwappable(const char* const file, int line,
+                               const T& example_value1,
+                               const char* const example_expression1,
+                               const T& example_value2,
+                               const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(
+      RegularTypeThunks<T>::GetOperationsIncludingSwap(), &example_value1,
+      example_expression1, &example_value2, example_expression2, message);
+  const std::string type_name = testing::internal::GetTypeName<T>();
+
+  if (!(checker.Check() && checker.CheckSwap())) {
+    ReportIrregularType(is_failure_fatal, file, line, type_name, message);
+    return;
+  }
+  checker.RecordSwapSpeed(type_name);
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeWithFastSwap(const char* const file, int line,
+                                  const T& example_value1,
+                                  const char* const example_expression1,
+                                  const T& example_value2,
+                                  const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(
+      RegularTypeThunks<T>::GetOperationsIncludingSwap(), &example_value1,
+      example_expression1, &example_value2, example_expression2, message);
+  const std::string type_name = testing::internal::GetTypeName<T>();
+
+  if (!(checker.Check() && checker.CheckSwap() &&
+        checker.CheckSwapSpeed(type_name))) {
+    ReportIrregularType(is_failure_fatal, file, line, type_name, message);
+  }
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckTriviallyRelocatableType(const char* const file, int line,
+                                   const T& example_value1,
+                                   const char* const example_expression1,
+                                   const T& example_value2,
+                                   const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &example_value1, example_expression1,
+                                   &example_value2, example_expression2,
+                                   message);
+  const std::string type_name = testing::internal::GetTypeName<T>();
+
+  if (!checker.Check()) {
+    ReportIrregularType(is_failure_fatal, file, line, type_name, message);
+    return;
+  }
+  if (!checker.CheckTriviallyRelocatable(type_name)) {
+    ReportFailure(is_failure_fatal, file, line,
+                  "Type expected to be trivially relocatable: '" + type_name +
+                      "'\n  " + message);
+  }
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeInParallel(const char* const file, int line,
+                                const T& example_value1,
+                                const char* const example_expression1,
+                                const T& example_value2,
+                                const char* const example_expression2) {
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<T>::GetOperations(),
+                                   &example_value1, example_expression1,
+                                   &example_value2, example_expression2,
+                                   message);
+  if (!checker.CheckInParallel(0)) {
+    ReportIrregularType(is_failure_fatal, file, line,
+                        testing::internal::GetTypeName<T>(), message);
+  }
+}
+
+template <bool is_failure_fatal, typename T>
+void CheckRegularTypeCountingOperations(const char* const file, int line,
+                                        const T& example_value1,
+                                        const char* const example_expression1,
+                                        const T& example_value2,
+                                        const char* const example_expression2) {
+  using Wrapper = OperationCountingWrapper<T>;
+  const Wrapper wrapper1(example_value1);
+  const Wrapper wrapper2(example_value2);
+
+  std::string message;
+  const RegularTypeChecker checker(RegularTypeThunks<Wrapper>::GetOperations(),
+                                   &wrapper1, example_expression1, &wrapper2,
+                                   example_expression2, message);
+
+  if (!checker.CheckCountingOperations()) {
+    ReportIrregularType(is_failure_fatal, file, line,
+                        testing::internal::GetTypeName<T>(), message);
+  }
+}
+
+// Returns an example for each element of a range whose elements are lvalues,
+// named after the range expression and the index of the element.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T, typename Range>
+std::vector<RegularTypeExample> MakeRangeExamples(
+    const Range& range, const char* const range_expression, std::deque<T>&,
+    std::true_type /*are_elements_lvalues*/) {
+  const RegularTypeOperations& operations =
+      RegularTypeThunks<T>::GetOperations();
+
+  std::vector<RegularTypeExample> examples;
+  std::size_t index{};
+
+  for (const T& value : range) {
+    examples.push_back(RegularTypeExample(
+        operations, &value,
+        std::string(range_expression) + '[' + std::to_string(index) + ']'));
+    ++index;
+  }
+  return examples;
+}
+
+// Overload for a range whose elements are not lvalues, for example the proxies
+// of an std::vector<bool>: the elements are first copied into owned_values, as
+// the examples must refer to objects that outlive them. (An std::deque, rather
+// than an std::vector, as its elements are true objects, even when T is bool,
+// and do not move when more elements are added.)
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T, typename Range>
+std::vector<RegularTypeExample> MakeRangeExamples(
+    const Range& range, const char* const range_expression,
+    std::deque<T>& owned_values, std::false_type /*are_elements_lvalues*/) {
+  for (auto&& value : range) {
+    owned_values.push_back(value);
+  }
+  return MakeRangeExamples(owned_values, range_expression, owned_values,
+                           std::true_type{});
+}
+
+// Returns an example for each element of the range. owned_values must outlive
+// the examples.
+//
+// INTERNAL IMPLEMENTATION - DO NOT USE IN A USER PROGRAM.
+template <typename T, typename Range>
+std::vector<RegularTypeExample> MakeRangeExamples(
+    const Range& range, const char* const range_expression,
+    std::deque<T>& owned_values) {
+  return MakeRangeExamples(
+      range, range_expression, owned_values,
+      std::is_lvalue_reference<decltype(*std::begin(range))>{});
+}
+
+// Checks the elements of a range (for example, a container) as examples. Each
+// element is only snapshotted once, so the setup cost is linear in the number
+// of elements.
+template <bool is_failure_fatal, typename Range>
+void CheckRegularRange(const char* const file, int line, const Range& range,
+                       const char* const range_expression) {
+  using T = typename std::decay<decltype(*std::begin(range))>::type;
+  const RegularTypeOperations& operations =
+      RegularTypeThunks<T>::GetOperations();
+
+  std::deque<T> owned_values;
+  std::vector<RegularTypeExample> examples =
+      MakeRangeExamples(range, range_expression, owned_values);
 
-#define ASSERT_REGULAR(example_value1, example_value2)                     \
-  ::example_implementation_by_niels_dekker::CheckRegularType<true>(        \
-      __FILE__, __LINE__, example_value1, #example_value1, example_value2, \
-      #example_value2)
+  std::string message;
+  const RegularTypeChecker checker(operations, std::move(examples), message);
+  if (!checker.Check()) {
+    ReportIrregularType(is_failure_fatal, file, line,
+                        testing::internal::GetTypeName<T>(), message);
+  } else if (RegularTypeChecker::IsTrivialityReportEnabled()) {
+    checker.RecordTrivialityReport(testing::internal::GetTypeName<T>());
+  }
+}
+
+// Overload for a braced-init-list, like `{ 1, 2, 3 }`.
+template <bool is_failure_fatal, typename T>
+void CheckRegularRange(const char* const file, int line,
+                       const std::initializer_list<T> range,
+                       const char* const range_expression) {
+  CheckRegularRange<is_failure_fatal, std::initializer_list<T>>(
+      file, line, range, range_expression);
+}
+
+}  // namespace example_implementation_by_niels_dekker
 
+// The macro's are defined separately, so that they can also be used together
+// with the C++20 module gtest_regular (see gtest-regular.cppm).
+#include "gtest-regular-macros.h"
 
 #endif  // GTEST_INCLUDE_GTEST_REGULAR_H_
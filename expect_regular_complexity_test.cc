@@ -0,0 +1,150 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Tests the macro EXPECT_REGULAR_COMPLEXITY(generator), using GoogleTest.
+
+#include "example_implementation/gtest-regular-complexity.h"
+
+// GoogleTest header files:
+#include <gtest/gtest-spi.h>  // For EXPECT_NONFATAL_FAILURE.
+#include <gtest/gtest.h>
+
+// Standard library header files:
+#include <algorithm>  // For equal and min.
+#include <cstddef>    // For size_t.
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<int> GenerateStdVector(const std::size_t size) {
+  return std::vector<int>(size);
+}
+
+std::string GenerateStdString(const std::size_t size) {
+  return std::string(size, 'x');
+}
+
+}  // namespace
+
+// The verdicts of EXPECT_REGULAR_COMPLEXITY depend on time measurements, so
+// these tests are disabled by default. They are run by the CTest test
+// hello_gtest_regular_timing_test, which has the label "timing".
+
+GTEST_TEST(TestRegularComplexity,
+           DISABLED_ExpectStdVectorHasConstantTimeMoves) {
+  EXPECT_REGULAR_COMPLEXITY(GenerateStdVector);
+}
+
+GTEST_TEST(TestRegularComplexity,
+           DISABLED_ExpectStdStringHasConstantTimeMoves) {
+  EXPECT_REGULAR_COMPLEXITY(GenerateStdString);
+}
+
+GTEST_TEST(TestRegularComplexity, DISABLED_SupportComplexityOptions) {
+  ::example_implementation_by_niels_dekker::ComplexityOptions options;
+  options.min_size = 8;
+  options.max_size = 8192;
+  options.growth_factor = 8;
+  EXPECT_REGULAR_COMPLEXITY_WITH_OPTIONS(GenerateStdVector, options);
+}
+
+GTEST_TEST(TestRegularComplexity,
+           DISABLED_IrregularLinearTimeMoveConstruction) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    IrregularType(const IrregularType&) = default;
+    IrregularType& operator=(const IrregularType&) = default;
+    IrregularType& operator=(IrregularType&&) = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(const std::size_t size) : data_(size) {}
+
+    IrregularType(IrregularType&& arg) noexcept : data_(arg.data_) {
+      // Potential performance bug in user code: the move-constructor does a
+      // deep copy.
+    }
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+
+   private:
+    std::vector<int> data_;
+  };
+
+  EXPECT_REGULAR_COMPLEXITY(
+      [](const std::size_t size) { return IrregularType(size); });
+}
+
+GTEST_TEST(TestRegularComplexity,
+           DISABLED_IrregularLinearTimeComparisonOfSizes) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+
+    explicit IrregularType(const std::size_t size) : data_(size) {}
+
+    bool operator==(const IrregularType& arg) const {
+      // Potential performance bug in user code: the elements are compared
+      // before the sizes.
+      const std::size_t min_size = std::min(data_.size(), arg.data_.size());
+      return std::equal(data_.cbegin(), data_.cbegin() + min_size,
+                        arg.data_.cbegin()) &&
+             (data_.size() == arg.data_.size());
+    }
+
+   private:
+    std::vector<int> data_;
+  };
+
+  EXPECT_REGULAR_COMPLEXITY(
+      [](const std::size_t size) { return IrregularType(size); });
+}
+
+// The options are checked before any measurement, so the following tests do
+// not depend on time measurements.
+GTEST_TEST(TestRegularComplexity, RejectZeroMinSize) {
+  ::example_implementation_by_niels_dekker::ComplexityOptions options;
+  options.min_size = 0;
+  EXPECT_NONFATAL_FAILURE(
+      EXPECT_REGULAR_COMPLEXITY_WITH_OPTIONS(GenerateStdVector, options),
+      "a min_size greater than zero");
+}
+
+GTEST_TEST(TestRegularComplexity, RejectGrowthFactorOfOne) {
+  ::example_implementation_by_niels_dekker::ComplexityOptions options;
+  options.growth_factor = 1;
+  EXPECT_NONFATAL_FAILURE(
+      EXPECT_REGULAR_COMPLEXITY_WITH_OPTIONS(GenerateStdVector, options),
+      "a growth_factor of at least 2");
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Tests the macro EXPECT_REGULAR_CONCURRENT(example_value1, example_value2,
+// thread_count), using GoogleTest.
+
+#include "example_implementation/gtest-regular-concurrent.h"
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+// Standard library header files:
+#include <atomic>      // For atomic.
+#include <cstddef>     // For size_t.
+#include <functional>  // For hash.
+#include <memory>      // For make_shared.
+#include <string>
+#include <thread>  // For this_thread.
+#include <vector>
+
+GTEST_TEST(TestRegularConcurrent, ExpectIntIsRegularConcurrently) {
+  EXPECT_REGULAR_CONCURRENT(1, 2, 4);
+}
+
+GTEST_TEST(TestRegularConcurrent, ExpectStdStringIsRegularConcurrently) {
+  EXPECT_REGULAR_CONCURRENT(std::string("a"), std::string(100, 'x'), 4);
+}
+
+GTEST_TEST(TestRegularConcurrent, ExpectStdSharedPtrIsRegularConcurrently) {
+  // The reference count of a shared_ptr is modified by copying, but it is
+  // atomic, and it is restored when the copies are destructed.
+  EXPECT_REGULAR_CONCURRENT(std::make_shared<int>(1), std::make_shared<int>(2),
+                            4);
+}
+
+GTEST_TEST(TestRegularConcurrent, IrregularThreadAffineCache) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(const int arg) : data_{arg} {}
+
+    IrregularType(const IrregularType& arg) : data_{arg.data_} {
+      arg.NoteReader();
+    }
+
+    IrregularType& operator=(const IrregularType& arg) {
+      data_ = arg.data_;
+      arg.NoteReader();
+      return *this;
+    }
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    // Bug in user code: copying an object modifies its (mutable) cache, which
+    // remains unchanged, as long as the object is only accessed by the thread
+    // that created it.
+    void NoteReader() const { reader_ = GetCurrentThreadHash(); }
+
+    static std::size_t GetCurrentThreadHash() {
+      return std::hash<std::thread::id>{}(std::this_thread::get_id());
+    }
+
+    int data_{};
+    mutable std::atomic<std::size_t> reader_{GetCurrentThreadHash()};
+  };
+
+  EXPECT_REGULAR_CONCURRENT(IrregularType(1), IrregularType(2), 4);
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Tests the macro STATIC_ASSERT_REGULAR(example_value1, example_value2) and
+// the function IsRegularConstexpr(example_value1, example_value2). Only
+// effective when compiled as C++14 or later.
+
+#include "example_implementation/gtest-regular-constexpr.h"
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+// Standard library header files:
+#include <climits>  // For INT_MAX.
+
+#if GTEST_REGULAR_HAS_CONSTEXPR_CHECKS
+
+namespace {
+
+using ::example_implementation_by_niels_dekker::IsRegularConstexpr;
+
+class LiteralPoint {
+ public:
+  constexpr LiteralPoint() = default;
+  constexpr LiteralPoint(const int x, const int y) : x_{x}, y_{y} {}
+
+  constexpr bool operator==(const LiteralPoint& arg) const {
+    return x_ == arg.x_ && y_ == arg.y_;
+  }
+  constexpr bool operator!=(const LiteralPoint& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  int x_{0};
+  int y_{0};
+};
+
+class IrregularLiteralType {
+ public:
+  constexpr IrregularLiteralType() = default;
+  constexpr explicit IrregularLiteralType(const int arg) : data_{arg} {}
+
+  constexpr IrregularLiteralType(const IrregularLiteralType&) {
+    // Potential bug in user code: copy-constructor does not copy any data.
+  }
+  constexpr IrregularLiteralType& operator=(const IrregularLiteralType&) =
+      default;
+
+  constexpr bool operator==(const IrregularLiteralType& arg) const {
+    return data_ == arg.data_;
+  }
+  constexpr bool operator!=(const IrregularLiteralType& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  int data_{0};
+};
+
+// Has an operator== that does not agree with its operator!=, for copies. Only
+// detected when the checks use both operators.
+class CopyMarkingLiteralType {
+ public:
+  constexpr CopyMarkingLiteralType() = default;
+  constexpr explicit CopyMarkingLiteralType(const int arg) : data_{arg} {}
+
+  constexpr CopyMarkingLiteralType(const CopyMarkingLiteralType& arg)
+      : data_{arg.data_}, is_copy_{true} {}
+  constexpr CopyMarkingLiteralType& operator=(const CopyMarkingLiteralType&) =
+      default;
+
+  constexpr bool operator==(const CopyMarkingLiteralType& arg) const {
+    // Potential bug in user code: a copy never compares equal.
+    return data_ == arg.data_ && !is_copy_ && !arg.is_copy_;
+  }
+  constexpr bool operator!=(const CopyMarkingLiteralType& arg) const {
+    return data_ != arg.data_;
+  }
+
+ private:
+  int data_{0};
+  bool is_copy_{false};
+};
+
+STATIC_ASSERT_REGULAR(1, INT_MAX);
+STATIC_ASSERT_REGULAR('a', 'b');
+STATIC_ASSERT_REGULAR(1.0, 2.0);
+STATIC_ASSERT_REGULAR(LiteralPoint(1, 2), LiteralPoint(2, 1));
+
+static_assert(!IsRegularConstexpr(IrregularLiteralType(1),
+                                  IrregularLiteralType(2)),
+              "IrregularLiteralType should be detected as irregular");
+static_assert(!IsRegularConstexpr(CopyMarkingLiteralType(1),
+                                  CopyMarkingLiteralType(2)),
+              "CopyMarkingLiteralType should be detected as irregular");
+
+}  // namespace
+
+GTEST_TEST(TestRegularConstexpr, ExpectLiteralPointIsRegular) {
+  constexpr bool is_regular =
+      IsRegularConstexpr(LiteralPoint(0, 1), LiteralPoint(1, 0));
+  EXPECT_TRUE(is_regular);
+}
+
+// Evaluates the checks at run-time, rather than at compile-time.
+GTEST_TEST(TestRegularConstexpr, DetectIrregularLiteralTypesAtRunTime) {
+  EXPECT_TRUE(IsRegularConstexpr(LiteralPoint(0, 1), LiteralPoint(1, 0)));
+  EXPECT_FALSE(
+      IsRegularConstexpr(IrregularLiteralType(1), IrregularLiteralType(2)));
+  EXPECT_FALSE(IsRegularConstexpr(CopyMarkingLiteralType(1),
+                                  CopyMarkingLiteralType(2)));
+}
+
+#endif  // GTEST_REGULAR_HAS_CONSTEXPR_CHECKS
@@ -0,0 +1,171 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Tests the macro EXPECT_REGULAR_IN_CONTAINERS(example_value1, example_value2),
+// using GoogleTest.
+
+#include "example_implementation/gtest-regular-containers.h"
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+// Standard library header files:
+#include <memory>  // For unique_ptr.
+#include <string>
+
+GTEST_TEST(TestRegularContainers, ExpectIntIsRegularInContainers) {
+  EXPECT_REGULAR_IN_CONTAINERS(1, 2);
+}
+
+GTEST_TEST(TestRegularContainers, ExpectStdStringIsRegularInContainers) {
+  EXPECT_REGULAR_IN_CONTAINERS(std::string("a"), std::string(100, 'x'));
+}
+
+namespace {
+
+// Returns the value of the property with the specified key, recorded by the
+// current test, or null when the test has not recorded such a property.
+const char* FindTestProperty(const std::string& key) {
+  const testing::TestResult& test_result =
+      *testing::UnitTest::GetInstance()->current_test_info()->result();
+
+  for (int i{}; i < test_result.test_property_count(); ++i) {
+    const testing::TestProperty& property = test_result.GetTestProperty(i);
+
+    if (key == property.key()) {
+      return property.value();
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+GTEST_TEST(TestRegularContainers, RecordOperationsPerContainer) {
+  EXPECT_REGULAR_IN_CONTAINERS(std::string("a"), std::string(100, 'x'));
+
+  // Grow, sort, lookup and erase of both sequences, and grow, lookup and erase
+  // of both maps.
+  for (const char* const sequence : {"vector", "deque"}) {
+    for (const char* const operation : {"grow", "sort", "lookup", "erase"}) {
+      EXPECT_NE(FindTestProperty(std::string("containers.") + sequence + '.' +
+                                 operation),
+                nullptr)
+          << sequence << '.' << operation;
+    }
+  }
+  for (const char* const map : {"map", "unordered_map"}) {
+    for (const char* const operation : {"grow", "lookup", "erase"}) {
+      EXPECT_NE(FindTestProperty(std::string("containers.") + map + '.' +
+                                 operation),
+                nullptr)
+          << map << '.' << operation;
+    }
+  }
+
+  const char* const vector_grow_property =
+      FindTestProperty("containers.vector.grow");
+  const char* const vector_lookup_property =
+      FindTestProperty("containers.vector.lookup");
+  const char* const map_grow_property = FindTestProperty("containers.map.grow");
+
+  ASSERT_NE(vector_grow_property, nullptr);
+  ASSERT_NE(vector_lookup_property, nullptr);
+  ASSERT_NE(map_grow_property, nullptr);
+
+  // Growing any of the containers copies each example once, and a lookup does
+  // not copy or move anything.
+  const std::string vector_grow = vector_grow_property;
+  EXPECT_NE(vector_grow.find(" ns per element, copy-constructions: 1000,"),
+            std::string::npos)
+      << vector_grow;
+  EXPECT_NE(vector_grow.find("move-constructions: "), std::string::npos)
+      << vector_grow;
+  EXPECT_NE(std::string(vector_lookup_property).find(" ns per element, none"),
+            std::string::npos);
+  EXPECT_NE(std::string(map_grow_property)
+                .find(" ns per element, copy-constructions: 1000"),
+            std::string::npos);
+}
+
+namespace {
+
+// Reuses the memory of the target of a move-assignment, and has a null pointer
+// when it is value-initialized or moved-from.
+class BufferReusingType {
+ public:
+  BufferReusingType() = default;
+  BufferReusingType(BufferReusingType&&) = default;
+  ~BufferReusingType() = default;
+
+  explicit BufferReusingType(const int arg) : data_{new int{arg}} {}
+
+  BufferReusingType(const BufferReusingType& arg)
+      : data_{(arg.data_ == nullptr) ? nullptr : new int{*arg.data_}} {}
+
+  BufferReusingType& operator=(const BufferReusingType& arg) {
+    data_.reset((arg.data_ == nullptr) ? nullptr : new int{*arg.data_});
+    return *this;
+  }
+
+  BufferReusingType& operator=(BufferReusingType&& arg) noexcept {
+    // Bug in user code: does not assign anything when the target has no
+    // memory to reuse, for example when it was moved-from. EXPECT_REGULAR
+    // does not detect this bug, but std::sort does move-assign to
+    // moved-from objects.
+    if (data_ != nullptr && arg.data_ != nullptr) {
+      *data_ = *arg.data_;
+    }
+    return *this;
+  }
+
+  bool operator==(const BufferReusingType& arg) const {
+    return (data_ == nullptr)
+               ? (arg.data_ == nullptr)
+               : ((arg.data_ != nullptr) && (*data_ == *arg.data_));
+  }
+  bool operator!=(const BufferReusingType& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  std::unique_ptr<int> data_;
+};
+
+}  // namespace
+
+GTEST_TEST(TestRegularContainers, ExpectBufferReusingTypeIsRegular) {
+  EXPECT_REGULAR(BufferReusingType(1), BufferReusingType(2));
+}
+
+GTEST_TEST(TestRegularContainers, IrregularMoveAssignmentToMovedFrom) {
+  EXPECT_REGULAR_IN_CONTAINERS(BufferReusingType(1), BufferReusingType(2));
+}
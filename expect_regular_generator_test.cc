@@ -0,0 +1,259 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Tests the macro EXPECT_REGULAR_GENERATED(generator), using GoogleTest.
+
+#include "example_implementation/gtest-regular-generator.h"
+
+// GoogleTest header files:
+#include <gtest/gtest-spi.h>  // For ScopedFakeTestPartResultReporter.
+#include <gtest/gtest.h>
+
+// Standard library header files:
+#include <cstddef>  // For size_t.
+#include <limits>   // For numeric_limits.
+#include <random>   // For mt19937_64.
+#include <string>
+#include <utility>  // For move.
+#include <vector>
+
+namespace {
+
+int GenerateInt(std::mt19937_64& engine, const std::size_t size) {
+  return static_cast<int>(engine() % (size + 1));
+}
+
+std::string GenerateStdString(std::mt19937_64& engine,
+                              const std::size_t size) {
+  std::string result(size, '\0');
+
+  for (char& c : result) {
+    c = static_cast<char>('a' + engine() % 26);
+  }
+  return result;
+}
+
+std::vector<int> GenerateStdVector(std::mt19937_64& engine,
+                                   const std::size_t size) {
+  std::vector<int> result(size);
+
+  for (int& element : result) {
+    element = static_cast<int>(engine() % 1000);
+  }
+  return result;
+}
+
+// A vector of integers that is not regular: its copy-assignment stops at the
+// first zero, in the style of strcpy.
+class ZeroTerminatedCopyAssignment {
+ public:
+  ZeroTerminatedCopyAssignment() = default;
+  ZeroTerminatedCopyAssignment(const ZeroTerminatedCopyAssignment&) = default;
+  ZeroTerminatedCopyAssignment(ZeroTerminatedCopyAssignment&&) = default;
+  ZeroTerminatedCopyAssignment& operator=(ZeroTerminatedCopyAssignment&&) =
+      default;
+  ~ZeroTerminatedCopyAssignment() = default;
+
+  explicit ZeroTerminatedCopyAssignment(std::vector<int> arg)
+      : data_(std::move(arg)) {}
+
+  // Bug in user code: the elements following a zero are not copied.
+  ZeroTerminatedCopyAssignment& operator=(
+      const ZeroTerminatedCopyAssignment& arg) {
+    std::vector<int> data;
+
+    for (const int element : arg.data_) {
+      if (element == 0) {
+        break;
+      }
+      data.push_back(element);
+    }
+    data_ = std::move(data);
+    return *this;
+  }
+
+  bool operator==(const ZeroTerminatedCopyAssignment& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const ZeroTerminatedCopyAssignment& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  std::vector<int> data_;
+};
+
+ZeroTerminatedCopyAssignment GenerateZeroTerminatedCopyAssignment(
+    std::mt19937_64& engine, const std::size_t size) {
+  return ZeroTerminatedCopyAssignment(GenerateStdVector(engine, size));
+}
+
+// Returns the value of the property with the specified key, recorded by the
+// current test, or null when the test has not recorded such a property.
+const char* FindTestProperty(const std::string& key) {
+  const testing::TestResult& test_result =
+      *testing::UnitTest::GetInstance()->current_test_info()->result();
+
+  for (int i{}; i < test_result.test_property_count(); ++i) {
+    const testing::TestProperty& property = test_result.GetTestProperty(i);
+
+    if (key == property.key()) {
+      return property.value();
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+GTEST_TEST(TestRegularGenerated, ExpectIntIsRegular) {
+  EXPECT_REGULAR_GENERATED(GenerateInt);
+}
+
+GTEST_TEST(TestRegularGenerated, ExpectStdStringIsRegular) {
+  EXPECT_REGULAR_GENERATED(GenerateStdString);
+}
+
+GTEST_TEST(TestRegularGenerated, ExpectStdVectorIsRegular) {
+  EXPECT_REGULAR_GENERATED(GenerateStdVector);
+}
+
+GTEST_TEST(TestRegularGenerated, SupportLambdaAndOptions) {
+  example_implementation_by_niels_dekker::GeneratorOptions options;
+  options.iteration_count = 10000;
+  options.max_size = 1000;
+  options.seed = 42;
+
+  EXPECT_REGULAR_GENERATED_WITH_OPTIONS(
+      [](std::mt19937_64& engine, const std::size_t size) {
+        return static_cast<double>(engine() % (size + 1)) / 8;
+      },
+      options);
+
+  EXPECT_STREQ(FindTestProperty("generator.seed"), "42");
+  EXPECT_NE(FindTestProperty("generator.checked_pairs"), nullptr);
+}
+
+GTEST_TEST(TestRegularGenerated, UseFixedSeedByDefault) {
+  const auto flag_seed = GTEST_FLAG_GET(random_seed);
+
+  GTEST_FLAG_SET(random_seed, 0);
+  EXPECT_REGULAR_GENERATED(GenerateInt);
+  EXPECT_STREQ(FindTestProperty("generator.seed"), "1");
+
+  GTEST_FLAG_SET(random_seed, 7);
+  EXPECT_REGULAR_GENERATED(GenerateInt);
+  EXPECT_STREQ(FindTestProperty("generator.seed"), "7");
+
+  GTEST_FLAG_SET(random_seed, flag_seed);
+}
+
+GTEST_TEST(TestRegularGenerated, IterationsDoNotAllocate) {
+  using example_implementation_by_niels_dekker::AllocationCounter;
+  using example_implementation_by_niels_dekker::GeneratorOptions;
+
+  const auto count_allocations = [](const std::size_t iteration_count) {
+    GeneratorOptions options;
+    options.iteration_count = iteration_count;
+
+    const AllocationCounter counter;
+    EXPECT_REGULAR_GENERATED_WITH_OPTIONS(GenerateInt, options);
+    return counter.GetCount().allocations;
+  };
+
+  // The first call may do allocations that are only done once, for example
+  // when adding the test properties.
+  count_allocations(10);
+  EXPECT_EQ(count_allocations(10), count_allocations(10000));
+}
+
+GTEST_TEST(TestRegularGenerated, ShrinkFailingPair) {
+  example_implementation_by_niels_dekker::GeneratorOptions options;
+  options.seed = 1;
+
+  using testing::ScopedFakeTestPartResultReporter;
+  testing::TestPartResultArray results;
+  {
+    const ScopedFakeTestPartResultReporter reporter(
+        ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD,
+        &results);
+    EXPECT_REGULAR_GENERATED_WITH_OPTIONS(GenerateZeroTerminatedCopyAssignment,
+                                          options);
+  }
+  ASSERT_EQ(results.size(), 1);
+
+  const std::string message = results.GetTestPartResult(0).message();
+  EXPECT_NE(message.find("Seed: 1\n"), std::string::npos);
+  EXPECT_NE(message.find("(shrunk from "), std::string::npos) << message;
+}
+
+// The options are checked before any value is generated.
+GTEST_TEST(TestRegularGenerated, RejectMaxSizeOfSizeMax) {
+  example_implementation_by_niels_dekker::GeneratorOptions options;
+  options.max_size = std::numeric_limits<std::size_t>::max();
+
+  EXPECT_NONFATAL_FAILURE(
+      EXPECT_REGULAR_GENERATED_WITH_OPTIONS(GenerateInt, options),
+      "a max_size less than SIZE_MAX");
+}
+
+GTEST_TEST(TestRegularGenerated, RejectZeroIterationCount) {
+  example_implementation_by_niels_dekker::GeneratorOptions options;
+  options.iteration_count = 0;
+
+  EXPECT_NONFATAL_FAILURE(
+      EXPECT_REGULAR_GENERATED_WITH_OPTIONS(GenerateInt, options),
+      "an iteration_count greater than zero");
+}
+
+GTEST_TEST(TestRegularGenerated, FindSmallBufferThreshold) {
+  using example_implementation_by_niels_dekker::FindSmallBufferThreshold;
+
+  // Any non-empty vector allocates memory.
+  EXPECT_EQ(FindSmallBufferThreshold(GenerateStdVector), 1u);
+
+  // The size of the small buffer of std::string depends on the implementation
+  // of the standard library.
+  const std::size_t threshold = FindSmallBufferThreshold(GenerateStdString);
+  EXPECT_GT(threshold, 0u);
+  EXPECT_LT(threshold, 100u);
+
+  // An int never allocates.
+  EXPECT_EQ(FindSmallBufferThreshold(GenerateInt, 10), 11u);
+}
+
+GTEST_TEST(TestRegularGenerated, IrregularZeroTerminatedCopyAssignment) {
+  EXPECT_REGULAR_GENERATED(GenerateZeroTerminatedCopyAssignment);
+}
+
+GTEST_TEST(TestRegularGenerated, IrregularGeneratorOfEqualValues) {
+  EXPECT_REGULAR_GENERATED([](std::mt19937_64&, std::size_t) { return 0; });
+}
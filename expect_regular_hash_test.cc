@@ -0,0 +1,216 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Tests the macro's EXPECT_REGULAR_HASHABLE(example_value1, example_value2)
+// and EXPECT_HASH_QUALITY(values), using GoogleTest.
+
+#include "example_implementation/gtest-regular-hash.h"
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+// Standard library header files:
+#include <cstddef>     // For size_t.
+#include <functional>  // For hash.
+#include <string>
+#include <utility>  // For move.
+#include <vector>
+
+namespace {
+
+// A type whose hash value is based on its address, instead of its value.
+class AddressHashedType {
+ public:
+  AddressHashedType() = default;
+  explicit AddressHashedType(const int arg) : data_{arg} {}
+
+  bool operator==(const AddressHashedType& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const AddressHashedType& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  int data_{0};
+};
+
+// A string type whose hash value is just its length.
+class LengthHashedString {
+ public:
+  LengthHashedString() = default;
+  explicit LengthHashedString(std::string arg) : data_{std::move(arg)} {}
+
+  std::size_t size() const { return data_.size(); }
+
+  bool operator==(const LengthHashedString& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const LengthHashedString& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  std::string data_;
+};
+
+// A type whose hash value tells whether it was move-assigned to.
+class MoveAssignMarkedType {
+ public:
+  MoveAssignMarkedType() = default;
+  explicit MoveAssignMarkedType(const int arg) : data_{arg} {}
+
+  MoveAssignMarkedType(const MoveAssignMarkedType& arg) : data_{arg.data_} {}
+  MoveAssignMarkedType(MoveAssignMarkedType&& arg) : data_{arg.data_} {}
+
+  MoveAssignMarkedType& operator=(const MoveAssignMarkedType& arg) {
+    data_ = arg.data_;
+    is_move_assigned_ = false;
+    return *this;
+  }
+  MoveAssignMarkedType& operator=(MoveAssignMarkedType&& arg) {
+    data_ = arg.data_;
+    is_move_assigned_ = true;
+    return *this;
+  }
+
+  int data() const { return data_; }
+  bool is_move_assigned() const { return is_move_assigned_; }
+
+  bool operator==(const MoveAssignMarkedType& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const MoveAssignMarkedType& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  int data_{0};
+  bool is_move_assigned_{false};
+};
+
+}  // namespace
+
+namespace std {
+
+template <>
+struct hash<AddressHashedType> {
+  std::size_t operator()(const AddressHashedType& arg) const {
+    // Bug in user code: the hash value is not based on the value.
+    return std::hash<const void*>{}(&arg);
+  }
+};
+
+template <>
+struct hash<LengthHashedString> {
+  std::size_t operator()(const LengthHashedString& arg) const {
+    // Performance bug in user code: strings of the same length collide.
+    return arg.size();
+  }
+};
+
+
+template <>
+struct hash<MoveAssignMarkedType> {
+  std::size_t operator()(const MoveAssignMarkedType& arg) const {
+    // Bug in user code: the hash value depends on how the value was assigned.
+    return std::hash<int>{}(arg.data()) + (arg.is_move_assigned() ? 1 : 0);
+  }
+};
+
+}  // namespace std
+
+namespace {
+
+std::vector<int> GenerateInts(const int count) {
+  std::vector<int> result;
+
+  for (int i{}; i < count; ++i) {
+    result.push_back(i);
+  }
+  return result;
+}
+
+std::vector<std::string> GenerateStdStrings(const int count) {
+  std::vector<std::string> result;
+
+  for (int i{}; i < count; ++i) {
+    result.push_back("string" + std::to_string(i));
+  }
+  return result;
+}
+
+}  // namespace
+
+GTEST_TEST(TestRegularHash, ExpectIntIsRegularAndHashable) {
+  EXPECT_REGULAR_HASHABLE(1, 2);
+}
+
+GTEST_TEST(TestRegularHash, ExpectStdStringIsRegularAndHashable) {
+  EXPECT_REGULAR_HASHABLE(std::string("a"), std::string(100, 'x'));
+}
+
+GTEST_TEST(TestRegularHash, ExpectHashQualityOfInts) {
+  EXPECT_HASH_QUALITY(GenerateInts(10000));
+}
+
+GTEST_TEST(TestRegularHash, ExpectHashQualityOfStdStrings) {
+  EXPECT_HASH_QUALITY(GenerateStdStrings(10000));
+}
+
+GTEST_TEST(TestRegularHash, SupportHashQualityThresholds) {
+  std::vector<LengthHashedString> values;
+
+  for (int i{}; i < 10; ++i) {
+    values.push_back(LengthHashedString(std::string(i, 'x')));
+  }
+  ::example_implementation_by_niels_dekker::HashQualityThresholds thresholds;
+  thresholds.max_collision_ratio = 0.0;
+  thresholds.max_mean_probe_length = 1.0;
+  EXPECT_HASH_QUALITY_WITH_THRESHOLDS(values, thresholds);
+}
+
+GTEST_TEST(TestRegularHash, IrregularAddressBasedHash) {
+  EXPECT_REGULAR_HASHABLE(AddressHashedType(1), AddressHashedType(2));
+}
+
+GTEST_TEST(TestRegularHash, IrregularLengthBasedHash) {
+  std::vector<LengthHashedString> values;
+
+  for (const std::string& value : GenerateStdStrings(1000)) {
+    values.push_back(LengthHashedString(value));
+  }
+  EXPECT_HASH_QUALITY(values);
+}
+
+GTEST_TEST(TestRegularHash, IrregularMoveAssignmentDependentHash) {
+  EXPECT_REGULAR_HASHABLE(MoveAssignMarkedType(1), MoveAssignMarkedType(2));
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Tests the macro EXPECT_TOTALLY_ORDERED(examples), using GoogleTest.
+
+#include "example_implementation/gtest-regular-ordering.h"
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+// Standard library header files:
+#include <cctype>   // For tolower.
+#include <climits>  // For INT_MAX.
+#include <cmath>    // For nan.
+#include <string>
+#include <vector>
+
+GTEST_TEST(TestRegularOrdering, ExpectIntIsTotallyOrdered) {
+  EXPECT_TOTALLY_ORDERED({0, 1, -1, INT_MAX, INT_MIN});
+}
+
+GTEST_TEST(TestRegularOrdering, ExpectStdStringIsTotallyOrdered) {
+  const std::vector<std::string> examples{"", "a", "ab", "b", "B"};
+  EXPECT_TOTALLY_ORDERED(examples);
+}
+
+GTEST_TEST(TestRegularOrdering, ExpectStdVectorBoolElementsAreTotallyOrdered) {
+  // The elements of an std::vector<bool> are not lvalues, so they are copied
+  // before they are checked.
+  const std::vector<bool> examples{false, true};
+  EXPECT_TOTALLY_ORDERED(examples);
+}
+
+GTEST_TEST(TestRegularOrdering, RecordComparisonCost) {
+  EXPECT_TOTALLY_ORDERED({1, 2, 3});
+
+  const testing::TestResult& test_result =
+      *testing::UnitTest::GetInstance()->current_test_info()->result();
+
+  ASSERT_EQ(test_result.test_property_count(), 2);
+  EXPECT_STREQ(test_result.GetTestProperty(0).key(),
+               "ordering.less_nanoseconds");
+  EXPECT_STREQ(test_result.GetTestProperty(1).key(),
+               "ordering.equal_nanoseconds");
+}
+
+GTEST_TEST(TestRegularOrdering, IrregularNaN) {
+  EXPECT_TOTALLY_ORDERED({0.0, 1.0, std::nan("")});
+}
+
+GTEST_TEST(TestRegularOrdering, IrregularCaseInsensitiveLess) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    explicit IrregularType(const char arg) : data_{arg} {}
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+    // Bug in user code: operator< is case-insensitive, whereas operator== is
+    // case-sensitive.
+    bool operator<(const IrregularType& arg) const {
+      return std::tolower(data_) < std::tolower(arg.data_);
+    }
+
+   private:
+    char data_{};
+  };
+
+  EXPECT_TOTALLY_ORDERED({IrregularType('a'), IrregularType('A')});
+}
+
+GTEST_TEST(TestRegularOrdering, IrregularNonTransitiveLess) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    explicit IrregularType(const int arg) : data_{arg} {}
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+    // Bug in user code: like rock-paper-scissors, 0 < 1, 1 < 2, but 2 < 0.
+    bool operator<(const IrregularType& arg) const {
+      return (data_ + 1) % 3 == arg.data_;
+    }
+
+   private:
+    int data_{};
+  };
+
+  EXPECT_TOTALLY_ORDERED(
+      {IrregularType(0), IrregularType(1), IrregularType(2)});
+}
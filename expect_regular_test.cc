@@ -29,19 +29,24 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 //
-// Tests the macro EXPECT_REGULAR(example_value1, example_value2), using
-// GoogleTest.
+// Tests the macro's EXPECT_REGULAR(example_value1, example_value2) and
+// EXPECT_REGULAR_RANGE(examples), using GoogleTest.
 
 #include "example_implementation/gtest-regular.h"  // For EXPECT_REGULAR
 
-// GoogleTest header file:
+// GoogleTest header files:
+#include <gtest/gtest-spi.h>  // For ScopedFakeTestPartResultReporter.
 #include <gtest/gtest.h>
 
 // Standard library header files:
 #include <climits>  // For INT_MAX.
 #include <cmath>    // For isnan.
 #include <initializer_list>
+#include <memory>     // For unique_ptr.
+#include <ostream>    // For ostream.
+#include <stdexcept>  // For runtime_error.
 #include <string>
+#include <utility>  // For move.
 #include <vector>
 
 GTEST_TEST(TestRegular, ExpectIntIsRegular) {
@@ -62,6 +67,168 @@ GTEST_TEST(TestRegular, ExpectStdStringIsRegular) {
   EXPECT_REGULAR(example_value1, example_value2);
 }
 
+GTEST_TEST(TestRegular, ExpectRegularRangeOfInts) {
+  EXPECT_REGULAR_RANGE({0, 1, -1, INT_MAX, INT_MIN});
+}
+
+GTEST_TEST(TestRegular, ExpectRegularRangeOfStdStrings) {
+  std::vector<std::string> examples;
+
+  for (char c{'A'}; c <= 'Z'; ++c) {
+    examples.push_back(std::string(1, c));
+    examples.push_back(std::string(100, c));
+  }
+  EXPECT_REGULAR_RANGE(examples);
+}
+
+GTEST_TEST(TestRegular, ExpectRegularRangeOfStdVectorBoolElements) {
+  // The elements of an std::vector<bool> are not lvalues, so they are copied
+  // before they are checked.
+  const std::vector<bool> examples{false, true};
+  EXPECT_REGULAR_RANGE(examples);
+}
+
+GTEST_TEST(TestRegular, IrregularRangeOfDuplicateExamples) {
+  // The examples of a range should all have different values.
+  const std::vector<int> examples{1, 2, 3, 2};
+  EXPECT_REGULAR_RANGE(examples);
+}
+
+namespace {
+
+// Counts how often a value of this type is printed by GoogleTest.
+class PrintCountingType {
+ public:
+  PrintCountingType() = default;
+  explicit PrintCountingType(const int arg) : data_{arg} {}
+
+  // User-provided (so not trivially copyable), so that the digest of an
+  // example is taken from its printout.
+  PrintCountingType(const PrintCountingType& arg) : data_{arg.data_} {}
+  PrintCountingType& operator=(const PrintCountingType& arg) {
+    data_ = arg.data_;
+    return *this;
+  }
+
+  bool operator==(const PrintCountingType& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const PrintCountingType& arg) const {
+    return !(*this == arg);
+  }
+
+  static unsigned& GetPrintCount() {
+    static unsigned print_count{};
+    return print_count;
+  }
+
+  friend void PrintTo(const PrintCountingType& value, std::ostream* const os) {
+    ++GetPrintCount();
+    *os << value.data_;
+  }
+
+ private:
+  int data_{0};
+};
+
+}  // namespace
+
+GTEST_TEST(TestRegular, PrintEachExampleOnlyOnceWhenRegular) {
+  PrintCountingType::GetPrintCount() = 0;
+  EXPECT_REGULAR(PrintCountingType(1), PrintCountingType(2));
+
+  // Only a digest of each example should be taken, as long as no failure
+  // message needs to be generated.
+  EXPECT_EQ(PrintCountingType::GetPrintCount(), 2u);
+}
+
+namespace {
+
+// Has an operator!= that modifies its left operand (a const object).
+template <typename T>
+class InequalityModifiedType {
+ public:
+  InequalityModifiedType() = default;
+  explicit InequalityModifiedType(const T& arg) : data_(arg) {}
+
+  bool operator==(const InequalityModifiedType& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const InequalityModifiedType&) const {
+    // Bug in user code: modifies the object, and always returns false.
+    data_ = data_ + data_;
+    return false;
+  }
+
+  friend void PrintTo(const InequalityModifiedType& value,
+                      std::ostream* const os) {
+    *os << value.data_;
+  }
+
+ private:
+  mutable T data_{};
+};
+
+// Returns the message of the single failure reported by EXPECT_REGULAR.
+template <typename T>
+std::string GetFailureMessage(const T& example_value1,
+                              const T& example_value2) {
+  using testing::ScopedFakeTestPartResultReporter;
+  testing::TestPartResultArray results;
+  {
+    const ScopedFakeTestPartResultReporter reporter(
+        ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD,
+        &results);
+    EXPECT_REGULAR(example_value1, example_value2);
+  }
+  return (results.size() == 1) ? results.GetTestPartResult(0).message()
+                               : std::string();
+}
+
+}  // namespace
+
+GTEST_TEST(TestRegular, ReportModifiedTriviallyCopyableExample) {
+  const std::string message =
+      GetFailureMessage(InequalityModifiedType<int>(1),
+                        InequalityModifiedType<int>(2));
+
+  EXPECT_NE(message.find("Left operand: example_value1\n"
+                         "    Which is: 4\n"
+                         "    Note: this example was modified during the test!"
+                         "\n    Original value: 1\n"),
+            std::string::npos)
+      << message;
+}
+
+GTEST_TEST(TestRegular, ReportModifiedExampleOfPrintedType) {
+  const std::string message =
+      GetFailureMessage(InequalityModifiedType<std::string>("a"),
+                        InequalityModifiedType<std::string>("b"));
+
+  EXPECT_NE(message.find("Left operand: example_value1\n"
+                         "    Which is: aaaa\n"
+                         "    Note: this example was modified during the test!"
+                         "\n    Original value: a\n"),
+            std::string::npos)
+      << message;
+}
+
+// The digest of a container is taken from its printout, which only has the
+// first 32 elements, so a modification of a later element is not detected.
+GTEST_TEST(TestRegular, ModificationBeyondPrintedElementsIsNotDetected) {
+  using example_implementation_by_niels_dekker::RegularTypeExample;
+  using example_implementation_by_niels_dekker::RegularTypeThunks;
+
+  std::vector<int> value(100);
+  const RegularTypeExample example(
+      RegularTypeThunks<std::vector<int>>::GetOperations(), &value, "value");
+
+  value.back() = 1;
+  EXPECT_FALSE(example.IsModified());
+  value.front() = 1;
+  EXPECT_TRUE(example.IsModified());
+}
+
 GTEST_TEST(TestRegular, SupportExplicitConstructors) {
   class ExplicitlyConstructible {
    public:
@@ -568,3 +735,910 @@ GTEST_TEST(TestRegular, IrregularUniquePtrWrapper) {
 
   EXPECT_REGULAR(IrregularType{1}, IrregularType({0, 1, 2}));
 }
+
+GTEST_TEST(TestRegular, ExpectStdVectorIsRegularWithoutAllocation) {
+  const std::vector<int> example_value1(1);
+  const std::vector<int> example_value2{1, 2, 3};
+  EXPECT_REGULAR_NOALLOC(example_value1, example_value2);
+}
+
+GTEST_TEST(TestRegular, ExpectUniquePtrWrapperIsRegularWithoutAllocation) {
+  class UniquePtrWrapper {
+   public:
+    UniquePtrWrapper() = default;
+    UniquePtrWrapper(UniquePtrWrapper&&) = default;
+    UniquePtrWrapper& operator=(UniquePtrWrapper&&) = default;
+    ~UniquePtrWrapper() = default;
+
+    explicit UniquePtrWrapper(const int arg) : data_{new int{arg}} {}
+
+    UniquePtrWrapper(const UniquePtrWrapper& arg)
+        : data_{(arg.data_ == nullptr) ? nullptr : new int{*arg.data_}} {}
+
+    UniquePtrWrapper& operator=(const UniquePtrWrapper& arg) {
+      data_.reset((arg.data_ == nullptr) ? nullptr : new int{*arg.data_});
+      return *this;
+    }
+
+    bool operator==(const UniquePtrWrapper& arg) const {
+      return (data_ == arg.data_) ||
+             ((data_ != nullptr) && (arg.data_ != nullptr) &&
+              (*data_ == *arg.data_));
+    }
+    bool operator!=(const UniquePtrWrapper& arg) const {
+      return !(*this == arg);
+    }
+
+   private:
+    std::unique_ptr<int> data_;
+  };
+
+  EXPECT_REGULAR_NOALLOC(UniquePtrWrapper(1), UniquePtrWrapper(2));
+}
+
+GTEST_TEST(TestRegular, IrregularAllocatingMoveConstruction) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    IrregularType(const IrregularType&) = default;
+    IrregularType& operator=(IrregularType&&) = default;
+    IrregularType& operator=(const IrregularType&) = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(std::initializer_list<int> arg) : data_(arg) {}
+
+    IrregularType(IrregularType&& arg) noexcept : data_(arg.data_) {
+      // Potential performance bug in user code: move-constructor copies the
+      // data, instead of moving it.
+    }
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    std::vector<int> data_;
+  };
+
+  EXPECT_REGULAR_NOALLOC(IrregularType{1}, IrregularType({0, 1, 2}));
+}
+
+#ifdef __cpp_aligned_new
+GTEST_TEST(TestRegular, IrregularAllocatingMoveConstructionOfOverAlignedData) {
+  struct alignas(64) OverAlignedData {
+    int value;
+  };
+
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(const int arg) : data_{new OverAlignedData{arg}} {}
+
+    IrregularType(const IrregularType& arg)
+        : data_{new OverAlignedData{arg.GetValue()}} {}
+
+    IrregularType(IrregularType&& arg)
+        : data_{new OverAlignedData{arg.GetValue()}} {
+      // Potential performance bug in user code: move-construction allocates
+      // (by an over-aligned operator new).
+    }
+
+    IrregularType& operator=(const IrregularType& arg) {
+      data_.reset(new OverAlignedData{arg.GetValue()});
+      return *this;
+    }
+
+    IrregularType& operator=(IrregularType&& arg) noexcept {
+      data_ = std::move(arg.data_);
+      return *this;
+    }
+
+    bool operator==(const IrregularType& arg) const {
+      return GetValue() == arg.GetValue();
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    int GetValue() const { return data_ == nullptr ? 0 : data_->value; }
+
+    std::unique_ptr<OverAlignedData> data_;
+  };
+
+  EXPECT_REGULAR_NOALLOC(IrregularType(1), IrregularType(2));
+}
+#endif
+
+GTEST_TEST(TestRegular, IrregularAllocatingValueInitialization) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    IrregularType(IrregularType&&) = default;
+    IrregularType& operator=(IrregularType&&) = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(const int arg) : data_{new int{arg}} {}
+
+    IrregularType(const IrregularType& arg) : data_{new int{*arg.data_}} {}
+
+    IrregularType& operator=(const IrregularType& arg) {
+      data_.reset(new int{*arg.data_});
+      return *this;
+    }
+
+    bool operator==(const IrregularType& arg) const {
+      return *data_ == *arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    // Potential performance issue in user code: value-initialization
+    // allocates memory.
+    std::unique_ptr<int> data_{new int{}};
+  };
+
+  EXPECT_REGULAR_NOALLOC(IrregularType(1), IrregularType(2));
+}
+
+GTEST_TEST(TestRegular, ExpectStdStringIsRegularWithNothrowMove) {
+  EXPECT_REGULAR_NOTHROW_MOVE(std::string("a"), std::string("b"));
+}
+
+namespace {
+
+// Returns the value of the property with the specified key, recorded by the
+// current test, or null when the test has not recorded such a property. Allows
+// a test to check a property, independently of the other properties.
+const char* FindTestProperty(const std::string& key) {
+  const testing::TestResult& test_result =
+      *testing::UnitTest::GetInstance()->current_test_info()->result();
+
+  for (int i{}; i < test_result.test_property_count(); ++i) {
+    const testing::TestProperty& property = test_result.GetTestProperty(i);
+
+    if (key == property.key()) {
+      return property.value();
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+GTEST_TEST(TestRegular, RecordNoexceptPropertyOnlyWhenCheckingNothrowMove) {
+  EXPECT_REGULAR(1, 2);
+  EXPECT_EQ(FindTestProperty("noexcept.int"), nullptr);
+
+  EXPECT_REGULAR_NOTHROW_MOVE(1, 2);
+  EXPECT_STREQ(
+      FindTestProperty("noexcept.int"),
+      "move-construction: noexcept, move-assignment: noexcept, swap: noexcept");
+}
+
+GTEST_TEST(TestRegular, RecordCheckTiming) {
+  using example_implementation_by_niels_dekker::CheckTimingRecorder;
+  using example_implementation_by_niels_dekker::RegularTypeChecker;
+
+  CheckTimingRecorder recorder;
+  RegularTypeChecker::SetListener(&recorder);
+  EXPECT_REGULAR(1, 2);
+  EXPECT_REGULAR(3, 4);
+  RegularTypeChecker::SetListener(nullptr);
+
+  const testing::TestResult& test_result =
+      *testing::UnitTest::GetInstance()->current_test_info()->result();
+
+  // The timing properties, in the order of the checks, ignoring any other
+  // property.
+  std::vector<std::string> keys;
+
+  for (int i{}; i < test_result.test_property_count(); ++i) {
+    const std::string key = test_result.GetTestProperty(i).key();
+
+    if (key.find("timing.") == 0) {
+      keys.push_back(key);
+    }
+  }
+  const std::vector<std::string> expected_keys{
+      "timing.TakeDigest",
+      "timing.CheckEqualToSelf",
+      "timing.CheckUnequal",
+      "timing.CheckValueInitialization",
+      "timing.CheckCopyAndMoveConstruct",
+      "timing.CheckAssigningDifferentValue",
+      "timing.CheckAssigningItsOriginalValue",
+      "timing.CheckSelfAssignment",
+      "timing.CheckCopyValue"};
+  EXPECT_EQ(keys, expected_keys);
+}
+
+GTEST_TEST(TestRegular, RecordOperationCounts) {
+  EXPECT_REGULAR_COUNTED(1, 2);
+  EXPECT_STREQ(FindTestProperty("operations.CheckEqualToSelf"),
+               "equality comparisons: 2, inequality comparisons: 2");
+  EXPECT_NE(FindTestProperty("operations.CheckCopyValue"), nullptr);
+}
+
+GTEST_TEST(TestRegular, CountOperationsOfUserCode) {
+  using example_implementation_by_niels_dekker::OperationCounter;
+  using Wrapper =
+      example_implementation_by_niels_dekker::OperationCountingWrapper<
+          std::string>;
+
+  std::vector<Wrapper> wrappers;
+  wrappers.reserve(2);
+  wrappers.emplace_back("a");
+  wrappers.emplace_back("b");
+
+  const OperationCounter counter;
+  std::vector<Wrapper> copies = wrappers;
+  std::vector<Wrapper> moved = std::move(copies);
+  moved.front() = wrappers.back();
+
+  EXPECT_EQ(counter.GetCount().copy_constructions, 2u);
+  EXPECT_EQ(counter.GetCount().move_constructions, 0u);
+  EXPECT_EQ(counter.GetCount().copy_assignments, 1u);
+  EXPECT_EQ(counter.GetCount().ToString(),
+            "copy-constructions: 2, copy-assignments: 1");
+}
+
+GTEST_TEST(TestRegular, RecordMemoryProfile) {
+  EXPECT_REGULAR_MEMORY_PROFILE(std::string("a"), std::string(100, 'x'));
+  EXPECT_STREQ(FindTestProperty("memory.value_initialization"),
+               "0 allocations (0 bytes)");
+  EXPECT_STREQ(FindTestProperty("memory.std::string(\"a\")"),
+               "copy-construction: 0 allocations (0 bytes), "
+               "copy-assignment: 0 allocations (0 bytes), "
+               "move-construction: 0 allocations (0 bytes), "
+               "destruction: 0 deallocations (0 bytes)");
+
+  const char* const long_string_property =
+      FindTestProperty("memory.std::string(100, 'x')");
+  ASSERT_NE(long_string_property, nullptr);
+
+  const std::string long_string_profile = long_string_property;
+  EXPECT_EQ(long_string_profile.find("copy-construction: 1 allocation ("),
+            0u);
+  EXPECT_NE(long_string_profile.find("move-construction: 0 allocations"),
+            std::string::npos);
+
+  // The destruction deallocates the bytes allocated by the copy-construction.
+  const std::size_t bytes_begin = long_string_profile.find('(');
+  const std::string copied_bytes = long_string_profile.substr(
+      bytes_begin, long_string_profile.find(')') - bytes_begin + 1);
+  EXPECT_NE(long_string_profile.find("destruction: 1 deallocation " +
+                                     copied_bytes),
+            std::string::npos);
+}
+
+GTEST_TEST(TestRegular, ExpectStdStringIsRegularWithoutLeaks) {
+  EXPECT_REGULAR_NO_LEAK(std::string("a"), std::string(100, 'x'));
+}
+
+namespace {
+
+// Leaks memory by self-assignment.
+class SelfAssignmentLeakingType {
+ public:
+  SelfAssignmentLeakingType() = default;
+
+  explicit SelfAssignmentLeakingType(const int arg) : data_{new int(arg)} {}
+
+  SelfAssignmentLeakingType(const SelfAssignmentLeakingType& arg)
+      : data_{(arg.data_ == nullptr) ? nullptr : new int(*arg.data_)} {}
+
+  SelfAssignmentLeakingType(SelfAssignmentLeakingType&& arg) noexcept
+      : data_{arg.data_} {
+    arg.data_ = nullptr;
+  }
+
+  SelfAssignmentLeakingType& operator=(const SelfAssignmentLeakingType& arg) {
+    int* const data = (arg.data_ == nullptr) ? nullptr : new int(*arg.data_);
+
+    // Bug in user code: the old data is not deleted by self-assignment.
+    if (this != &arg) {
+      delete data_;
+    }
+    data_ = data;
+    return *this;
+  }
+
+  SelfAssignmentLeakingType& operator=(
+      SelfAssignmentLeakingType&& arg) noexcept {
+    if (this != &arg) {
+      delete data_;
+      data_ = arg.data_;
+      arg.data_ = nullptr;
+    }
+    return *this;
+  }
+
+  ~SelfAssignmentLeakingType() { delete data_; }
+
+  bool operator==(const SelfAssignmentLeakingType& arg) const {
+    return (data_ == nullptr)
+               ? (arg.data_ == nullptr)
+               : ((arg.data_ != nullptr) && (*data_ == *arg.data_));
+  }
+  bool operator!=(const SelfAssignmentLeakingType& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  int* data_{nullptr};
+};
+
+}  // namespace
+
+GTEST_TEST(TestRegular, IrregularLeakBySelfAssignment) {
+  EXPECT_REGULAR_NO_LEAK(SelfAssignmentLeakingType(1),
+                         SelfAssignmentLeakingType(2));
+}
+
+GTEST_TEST(TestRegular, LeakFailureMessageNamesCheck) {
+  // Without leak detection, the type appears to be regular.
+  EXPECT_REGULAR(SelfAssignmentLeakingType(1), SelfAssignmentLeakingType(2));
+
+  using testing::ScopedFakeTestPartResultReporter;
+  testing::TestPartResultArray results;
+  {
+    const ScopedFakeTestPartResultReporter reporter(
+        ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD,
+        &results);
+    EXPECT_REGULAR_NO_LEAK(SelfAssignmentLeakingType(1),
+                           SelfAssignmentLeakingType(2));
+  }
+  ASSERT_EQ(results.size(), 1);
+
+  const std::string message = results.GetTestPartResult(0).message();
+  EXPECT_NE(message.find("CheckSelfAssignment should not leak memory!\n"
+                         "    Leaked: "),
+            std::string::npos)
+      << message;
+}
+
+GTEST_TEST(TestRegular, IrregularMoveConstructionWithoutNoexcept) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    IrregularType(const IrregularType&) = default;
+    IrregularType& operator=(const IrregularType&) = default;
+    IrregularType& operator=(IrregularType&&) = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(std::initializer_list<int> arg) : data_(arg) {}
+
+    // Potential performance bug in user code: the move-constructor is not
+    // noexcept, so std::vector<IrregularType> copies its elements when it
+    // reallocates.
+    IrregularType(IrregularType&& arg) : data_(std::move(arg.data_)) {}
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    std::vector<int> data_;
+  };
+
+  EXPECT_REGULAR_NOTHROW_MOVE(IrregularType{1}, IrregularType({0, 1, 2}));
+}
+
+GTEST_TEST(TestRegular, ExpectIntIsRegularSwappable) {
+  EXPECT_REGULAR_SWAPPABLE(1, 2);
+}
+
+GTEST_TEST(TestRegular, ExpectStdStringIsRegularSwappable) {
+  EXPECT_REGULAR_SWAPPABLE(std::string("a"), std::string(100, 'x'));
+}
+
+namespace {
+
+// Has a custom swap, as a "hidden friend", found by argument-dependent lookup.
+class CustomSwappableType {
+ public:
+  CustomSwappableType() = default;
+  explicit CustomSwappableType(std::initializer_list<int> arg) : data_(arg) {}
+
+  friend void swap(CustomSwappableType& left,
+                   CustomSwappableType& right) noexcept {
+    left.data_.swap(right.data_);
+  }
+
+  bool operator==(const CustomSwappableType& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const CustomSwappableType& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  std::vector<int> data_;
+};
+
+// Swaps by "XOR swap", which sets the value of an object to zero, when it is
+// swapped with itself.
+class XorSwappingType {
+ public:
+  XorSwappingType() = default;
+  explicit XorSwappingType(const int arg) : data_{arg} {}
+
+  friend void swap(XorSwappingType& left, XorSwappingType& right) noexcept {
+    // Bug in user code: does not support self-swap.
+    left.data_ ^= right.data_;
+    right.data_ ^= left.data_;
+    left.data_ ^= right.data_;
+  }
+
+  bool operator==(const XorSwappingType& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const XorSwappingType& arg) const { return !(*this == arg); }
+
+ private:
+  int data_{0};
+};
+
+// Has a custom swap that is much slower than the generic swap.
+class SlowSwappingType {
+ public:
+  SlowSwappingType() = default;
+  explicit SlowSwappingType(const int arg) : data_{arg} {}
+
+  friend void swap(SlowSwappingType& left, SlowSwappingType& right) noexcept {
+    // Performance bug in user code: exchanges the values one bit at a time,
+    // through volatile references.
+    volatile int& left_data = left.data_;
+    volatile int& right_data = right.data_;
+
+    for (unsigned bit{}; bit < 32; ++bit) {
+      const int difference =
+          (left_data ^ right_data) & static_cast<int>(1u << bit);
+      left_data = left_data ^ difference;
+      right_data = right_data ^ difference;
+    }
+  }
+
+  bool operator==(const SlowSwappingType& arg) const {
+    return data_ == arg.data_;
+  }
+  bool operator!=(const SlowSwappingType& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  int data_{0};
+};
+
+}  // namespace
+
+GTEST_TEST(TestRegular, ExpectCustomSwappableTypeIsRegularSwappable) {
+  EXPECT_REGULAR_SWAPPABLE(CustomSwappableType{1},
+                           CustomSwappableType({0, 1, 2}));
+}
+
+GTEST_TEST(TestRegular, RecordSwapDurations) {
+  EXPECT_REGULAR_SWAPPABLE(1, 2);
+  EXPECT_REGULAR_SWAPPABLE(CustomSwappableType{1},
+                           CustomSwappableType({0, 1, 2}));
+
+  const char* const int_swap_property = FindTestProperty("swap.int");
+  ASSERT_NE(int_swap_property, nullptr);
+  EXPECT_EQ(std::string(int_swap_property).find("generic swap: "), 0u);
+
+  const char* const custom_swap_property = FindTestProperty(
+      "swap." + testing::internal::GetTypeName<CustomSwappableType>());
+  ASSERT_NE(custom_swap_property, nullptr);
+
+  const std::string custom_swap_durations = custom_swap_property;
+  EXPECT_EQ(custom_swap_durations.find("custom swap: "), 0u);
+  EXPECT_NE(custom_swap_durations.find(" ns, generic swap: "),
+            std::string::npos);
+  EXPECT_NE(custom_swap_durations.find(" ns, ratio: "), std::string::npos);
+}
+
+// EXPECT_REGULAR_SWAPPABLE only reports the durations of a slow custom swap.
+GTEST_TEST(TestRegular, ExpectSlowSwappingTypeIsRegularSwappable) {
+  EXPECT_REGULAR_SWAPPABLE(SlowSwappingType(1), SlowSwappingType(2));
+  EXPECT_NE(FindTestProperty(
+                "swap." + testing::internal::GetTypeName<SlowSwappingType>()),
+            nullptr);
+}
+
+GTEST_TEST(TestRegular, ExpectIntHasFastSwap) {
+  EXPECT_REGULAR_FAST_SWAP(1, 2);
+}
+
+GTEST_TEST(TestRegular, IrregularSelfSwap) {
+  EXPECT_REGULAR_SWAPPABLE(XorSwappingType(1), XorSwappingType(2));
+}
+
+// The verdict of EXPECT_REGULAR_FAST_SWAP depends on time measurements, so this
+// test is disabled by default. It is run by the CTest test
+// hello_gtest_regular_timing_test, which has the label "timing".
+GTEST_TEST(TestRegular, DISABLED_IrregularSlowCustomSwap) {
+  EXPECT_REGULAR_FAST_SWAP(SlowSwappingType(1), SlowSwappingType(2));
+}
+
+namespace {
+
+// Owns its data by an std::unique_ptr, and copies it deeply.
+class UniquePtrOwner {
+ public:
+  UniquePtrOwner() = default;
+  UniquePtrOwner(UniquePtrOwner&&) = default;
+  UniquePtrOwner& operator=(UniquePtrOwner&&) = default;
+  ~UniquePtrOwner() = default;
+
+  explicit UniquePtrOwner(const int arg) : data_{new int{arg}} {}
+
+  UniquePtrOwner(const UniquePtrOwner& arg)
+      : data_{(arg.data_ == nullptr) ? nullptr : new int{*arg.data_}} {}
+
+  UniquePtrOwner& operator=(const UniquePtrOwner& arg) {
+    data_.reset((arg.data_ == nullptr) ? nullptr : new int{*arg.data_});
+    return *this;
+  }
+
+  bool operator==(const UniquePtrOwner& arg) const {
+    return (data_ == nullptr)
+               ? (arg.data_ == nullptr)
+               : ((arg.data_ != nullptr) && (*data_ == *arg.data_));
+  }
+  bool operator!=(const UniquePtrOwner& arg) const { return !(*this == arg); }
+
+ private:
+  std::unique_ptr<int> data_;
+};
+
+// Shares its (immutable) data with its copies, by an std::shared_ptr.
+class SharedPtrOwner {
+ public:
+  SharedPtrOwner() = default;
+  explicit SharedPtrOwner(const int arg)
+      : data_{std::make_shared<const int>(arg)} {}
+
+  bool operator==(const SharedPtrOwner& arg) const {
+    return (data_ == nullptr)
+               ? (arg.data_ == nullptr)
+               : ((arg.data_ != nullptr) && (*data_ == *arg.data_));
+  }
+  bool operator!=(const SharedPtrOwner& arg) const { return !(*this == arg); }
+
+ private:
+  std::shared_ptr<const int> data_;
+};
+
+// Has a pointer to one of its own data members.
+class SelfReferentialType {
+ public:
+  SelfReferentialType() = default;
+  explicit SelfReferentialType(const int arg) : data_{arg} {}
+
+  SelfReferentialType(const SelfReferentialType& arg) : data_{*arg.pointer_} {}
+
+  SelfReferentialType& operator=(const SelfReferentialType& arg) {
+    *pointer_ = *arg.pointer_;
+    return *this;
+  }
+
+  bool operator==(const SelfReferentialType& arg) const {
+    return *pointer_ == *arg.pointer_;
+  }
+  bool operator!=(const SelfReferentialType& arg) const {
+    return !(*this == arg);
+  }
+
+ private:
+  int data_{0};
+
+  // Not trivially relocatable: after memcpy, the pointer still points to the
+  // data of the original object.
+  int* pointer_{&data_};
+};
+
+}  // namespace
+
+GTEST_TEST(TestRegular, ExpectUniquePtrOwnerIsTriviallyRelocatable) {
+  EXPECT_TRIVIALLY_RELOCATABLE(UniquePtrOwner(1), UniquePtrOwner(2));
+}
+
+GTEST_TEST(TestRegular, ExpectSharedPtrOwnerIsTriviallyRelocatable) {
+  EXPECT_TRIVIALLY_RELOCATABLE(SharedPtrOwner(1), SharedPtrOwner(2));
+}
+
+GTEST_TEST(TestRegular, RecordTriviallyRelocatableProperty) {
+  EXPECT_TRIVIALLY_RELOCATABLE(1, 2);
+  EXPECT_STREQ(FindTestProperty("trivially_relocatable.int"), "true");
+}
+
+GTEST_TEST(TestRegular, ExpectSelfReferentialTypeIsRegular) {
+  // The type is regular, but it is not trivially relocatable.
+  EXPECT_REGULAR(SelfReferentialType(1), SelfReferentialType(2));
+}
+
+GTEST_TEST(TestRegular, IrregularTriviallyRelocatableSelfReferentialType) {
+  EXPECT_TRIVIALLY_RELOCATABLE(SelfReferentialType(1), SelfReferentialType(2));
+}
+
+// A failing check of a bitwise relocated object that has already released the
+// resources of the original object must not restore the original object, as
+// that would free those resources twice (which would be reported by the
+// AddressSanitizer build, GTEST_REGULAR_SANITIZER=address).
+GTEST_TEST(TestRegular, ReportRelocatedObjectWhoseAssignmentReleasesResources) {
+  class IrregularType {
+   public:
+    IrregularType() : data_{new int(0)} {}
+    explicit IrregularType(const int arg) : data_{new int(arg)} {}
+    IrregularType(const IrregularType& arg) : data_{new int(*arg.data_)} {}
+    ~IrregularType() = default;
+
+    // Bug in user code: assigns a wrong value, after releasing the original
+    // one, when the object was relocated.
+    IrregularType& operator=(const IrregularType& arg) {
+      data_.reset(new int((self_ == this) ? *arg.data_ : 0));
+      return *this;
+    }
+
+    bool operator==(const IrregularType& arg) const {
+      return *data_ == *arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    const IrregularType* self_{this};
+    std::unique_ptr<int> data_;
+  };
+
+  using testing::ScopedFakeTestPartResultReporter;
+  testing::TestPartResultArray results;
+  {
+    const ScopedFakeTestPartResultReporter reporter(
+        ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD,
+        &results);
+    EXPECT_TRIVIALLY_RELOCATABLE(IrregularType(1), IrregularType(2));
+  }
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_NE(std::string(results.GetTestPartResult(0).message())
+                .find("even when the target object was bitwise relocated"),
+            std::string::npos);
+}
+
+namespace {
+
+// Enables the triviality report, during its lifetime.
+class ScopedTrivialityReport {
+ public:
+  ScopedTrivialityReport() {
+    example_implementation_by_niels_dekker::RegularTypeChecker::
+        SetTrivialityReportEnabled(true);
+  }
+  ~ScopedTrivialityReport() {
+    example_implementation_by_niels_dekker::RegularTypeChecker::
+        SetTrivialityReportEnabled(false);
+  }
+  ScopedTrivialityReport(const ScopedTrivialityReport&) = delete;
+  ScopedTrivialityReport& operator=(const ScopedTrivialityReport&) = delete;
+};
+
+}  // namespace
+
+GTEST_TEST(TestRegular, RecordTrivialityReport) {
+  const ScopedTrivialityReport scoped_triviality_report;
+  EXPECT_REGULAR(1, 2);
+  EXPECT_REGULAR(std::string("a"), std::string("b"));
+
+  const std::string string_type_name =
+      testing::internal::GetTypeName<std::string>();
+
+  EXPECT_STREQ(FindTestProperty("triviality.int"),
+               "trivially copyable: true, trivially destructible: true, "
+               "trivially default constructible: true");
+  EXPECT_STREQ(FindTestProperty("triviality." + string_type_name),
+               "trivially copyable: false, trivially destructible: false, "
+               "trivially default constructible: false");
+
+  // No advisory for int, as it is trivial already, nor for std::string, as
+  // its copies are not bytewise identical.
+  EXPECT_EQ(FindTestProperty("triviality_advisory.int"), nullptr);
+  EXPECT_EQ(FindTestProperty("triviality_advisory." + string_type_name),
+            nullptr);
+}
+
+GTEST_TEST(TestRegular, RecordTrivialityAdvisory) {
+  class HandWrittenCopyType {
+   public:
+    HandWrittenCopyType() = default;
+    explicit HandWrittenCopyType(const int arg) : data_{arg} {}
+
+    // Potential performance issue in user code: the copy-constructor could
+    // have been defaulted, which would make the type trivially copyable.
+    HandWrittenCopyType(const HandWrittenCopyType& arg) : data_{arg.data_} {}
+
+    HandWrittenCopyType& operator=(const HandWrittenCopyType&) = default;
+
+    bool operator==(const HandWrittenCopyType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const HandWrittenCopyType& arg) const {
+      return !(*this == arg);
+    }
+
+   private:
+    int data_{0};
+  };
+
+  const ScopedTrivialityReport scoped_triviality_report;
+  EXPECT_REGULAR(HandWrittenCopyType(1), HandWrittenCopyType(2));
+
+  const std::string type_name =
+      testing::internal::GetTypeName<HandWrittenCopyType>();
+  const char* const triviality = FindTestProperty("triviality." + type_name);
+  const char* const advisory =
+      FindTestProperty("triviality_advisory." + type_name);
+
+  ASSERT_NE(triviality, nullptr);
+  ASSERT_NE(advisory, nullptr);
+  EXPECT_EQ(std::string(triviality).find(
+                "trivially copyable: false, trivially destructible: true"),
+            0u);
+  EXPECT_EQ(std::string(advisory).find("could be trivially copyable"), 0u);
+}
+
+GTEST_TEST(TestRegular, NoTrivialityReportByDefault) {
+  EXPECT_REGULAR(1, 2);
+  EXPECT_EQ(FindTestProperty("triviality.int"), nullptr);
+}
+
+GTEST_TEST(TestRegular, ExpectStdVectorIsRegularInParallel) {
+  EXPECT_REGULAR_PARALLEL(std::vector<int>(1000, 1), std::vector<int>(2000));
+}
+
+// Each parallel check has its own copies of the examples, so a copy-assignment
+// that modifies its source does not cause a data race (which would be reported
+// by the ThreadSanitizer build, GTEST_REGULAR_SANITIZER=thread). Uses four
+// threads, even when the hardware supports only one.
+GTEST_TEST(TestRegular, ParallelCheckOfSourceModifyingAssignment) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    IrregularType(const IrregularType&) = default;
+    IrregularType(IrregularType&&) = default;
+    IrregularType& operator=(IrregularType&&) = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(const int arg) : data_{arg} {}
+
+    IrregularType& operator=(const IrregularType& arg) {
+      // Potential bug in user code: copy-assignment modifies the source object.
+      data_ = arg.data_;
+      arg.data_ = 0;
+      return *this;
+    }
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    mutable int data_{0};
+  };
+
+  using example_implementation_by_niels_dekker::RegularTypeChecker;
+  using example_implementation_by_niels_dekker::RegularTypeThunks;
+
+  // The sequential check modifies its examples, so each check gets its own.
+  const IrregularType sequential_examples[] = {IrregularType(1),
+                                               IrregularType(2)};
+  const IrregularType parallel_examples[] = {IrregularType(1),
+                                             IrregularType(2)};
+  std::string sequential_message;
+  std::string parallel_message;
+
+  EXPECT_FALSE(RegularTypeChecker(
+                   RegularTypeThunks<IrregularType>::GetOperations(),
+                   &sequential_examples[0], "example1", &sequential_examples[1],
+                   "example2", sequential_message)
+                   .Check());
+  EXPECT_FALSE(RegularTypeChecker(
+                   RegularTypeThunks<IrregularType>::GetOperations(),
+                   &parallel_examples[0], "example1", &parallel_examples[1],
+                   "example2", parallel_message)
+                   .CheckInParallel(4));
+  EXPECT_EQ(parallel_message.substr(0, sequential_message.size()),
+            sequential_message);
+}
+
+// An exception thrown by a parallel check becomes a failure message, instead of
+// terminating the test program.
+GTEST_TEST(TestRegular, ParallelCheckReportsException) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    IrregularType(const IrregularType&) = default;
+    IrregularType(IrregularType&&) = default;
+    IrregularType& operator=(IrregularType&&) = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(const int arg) : data_{arg} {}
+
+    IrregularType& operator=(const IrregularType&) {
+      throw std::runtime_error("copy-assignment failed");
+    }
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    int data_{0};
+  };
+
+  using example_implementation_by_niels_dekker::RegularTypeChecker;
+  using example_implementation_by_niels_dekker::RegularTypeThunks;
+
+  const IrregularType examples[] = {IrregularType(1), IrregularType(2)};
+  std::string message;
+
+  EXPECT_FALSE(RegularTypeChecker(
+                   RegularTypeThunks<IrregularType>::GetOperations(),
+                   &examples[0], "example1", &examples[1], "example2", message)
+                   .CheckInParallel(4));
+  EXPECT_NE(message.find(" threw an exception: copy-assignment failed"),
+            std::string::npos);
+}
+
+GTEST_TEST(TestRegular, ParallelFailureMessageStartsWithSequentialMessage) {
+  class IrregularType {
+   public:
+    IrregularType() = default;
+    IrregularType(IrregularType&&) = default;
+    IrregularType& operator=(const IrregularType&) = default;
+    IrregularType& operator=(IrregularType&&) = default;
+    ~IrregularType() = default;
+
+    explicit IrregularType(const int arg) : data_{arg} {}
+
+    // Bug in user code: the copy-constructor does not copy anything.
+    IrregularType(const IrregularType&) {}
+
+    bool operator==(const IrregularType& arg) const {
+      return data_ == arg.data_;
+    }
+    bool operator!=(const IrregularType& arg) const { return !(*this == arg); }
+
+   private:
+    int data_{0};
+  };
+
+  using testing::ScopedFakeTestPartResultReporter;
+  testing::TestPartResultArray sequential_results;
+  testing::TestPartResultArray parallel_results;
+  {
+    const ScopedFakeTestPartResultReporter reporter(
+        ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD,
+        &sequential_results);
+    EXPECT_REGULAR(IrregularType(1), IrregularType(2));
+  }
+  {
+    const ScopedFakeTestPartResultReporter reporter(
+        ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD,
+        &parallel_results);
+    EXPECT_REGULAR_PARALLEL(IrregularType(1), IrregularType(2));
+  }
+  ASSERT_EQ(sequential_results.size(), 1);
+  ASSERT_EQ(parallel_results.size(), 1);
+
+  const std::string sequential_message =
+      sequential_results.GetTestPartResult(0).message();
+  const std::string parallel_message =
+      parallel_results.GetTestPartResult(0).message();
+
+  EXPECT_EQ(parallel_message.substr(0, sequential_message.size()),
+            sequential_message);
+}
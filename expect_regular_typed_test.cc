@@ -0,0 +1,103 @@
+// Copyright (c) 2019, Niels Dekker (LKEB, Leiden University Medical Center)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Tests the macro REGULAR_TYPED_TEST_SUITE(test_suite_name, types), using
+// GoogleTest.
+
+#include "example_implementation/gtest-regular-typed.h"
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+// Standard library header files:
+#include <memory>  // For shared_ptr.
+#include <string>
+#include <utility>  // For pair.
+#include <vector>
+
+namespace {
+
+struct Point {
+  int x;
+  int y;
+
+  bool operator==(const Point& other) const {
+    return x == other.x && y == other.y;
+  }
+  bool operator!=(const Point& other) const { return !(*this == other); }
+};
+
+}  // namespace
+
+namespace example_implementation_by_niels_dekker {
+
+template <>
+struct RegularTypeExampleFactory<std::string> {
+  static std::vector<std::string> MakeExamples() {
+    return {"", "a", std::string(100, 'x')};
+  }
+};
+
+template <>
+struct RegularTypeExampleFactory<std::vector<int>> {
+  static std::vector<std::vector<int>> MakeExamples() {
+    return {{}, {1}, {1, 2, 3}};
+  }
+};
+
+template <>
+struct RegularTypeExampleFactory<std::pair<int, std::string>> {
+  static std::vector<std::pair<int, std::string>> MakeExamples() {
+    return {{0, "a"}, {0, "b"}, {1, "a"}};
+  }
+};
+
+template <>
+struct RegularTypeExampleFactory<std::shared_ptr<int>> {
+  static std::vector<std::shared_ptr<int>> MakeExamples() {
+    return {nullptr, std::make_shared<int>(1)};
+  }
+};
+
+template <>
+struct RegularTypeExampleFactory<Point> {
+  static std::vector<Point> MakeExamples() { return {{0, 0}, {0, 1}, {1, 0}}; }
+};
+
+}  // namespace example_implementation_by_niels_dekker
+
+REGULAR_TYPED_TEST_SUITE(ArithmeticTypes,
+                         ::testing::Types<char, int, unsigned long, double>);
+
+REGULAR_TYPED_TEST_SUITE(ClassTypes,
+                         ::testing::Types<std::string, std::vector<int>,
+                                          std::pair<int, std::string>,
+                                          std::shared_ptr<int>, Point>);
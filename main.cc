@@ -30,43 +30,110 @@
 //
 //
 // Implements the main(argc, argv) function of the gtest-regular example.
+//
+// Usage:
+//
+//   hello_gtest_regular [--jobs=N] [--timing_report=FILE]
+//                       [--timing_baseline=FILE] [--timing_ratio=R]
+//                       [--timing_min_ms=M] [GoogleTest flags]
+//
+// With --jobs=N (N > 1), the tests are run by N worker processes, each running
+// its own shard of the tests (as specified by GTEST_TOTAL_SHARDS and
+// GTEST_SHARD_INDEX). The results of all shards are then verified together.
+// Worker processes are only supported on POSIX platforms. When an output file
+// is specified (by --gtest_output or GTEST_OUTPUT), each worker writes its own
+// file, named after the shard. For example, "xml:report.xml" becomes
+// "report.shard0.xml", "report.shard1.xml", etc.
+//
+// With --timing_report=FILE, the elapsed time of each test that has run is
+// written to the specified file, as a JSON object that maps the full name of
+// each test to its elapsed time, in milliseconds. Such a file may be stored,
+// and passed later as --timing_baseline=FILE. The program then fails when the
+// elapsed time of a test exceeds R times its baseline time (by default R = 2).
+// Baseline times shorter than M milliseconds (by default M = 10) are rounded
+// up to M, as such short times are mostly noise.
+//
+// Tests whose verdict depends on time measurements are disabled by default
+// (their names start with "DISABLED_"), as their verdict may be affected by
+// the load of the machine. They are run by --gtest_also_run_disabled_tests.
 
 // GoogleTest header file:
 #include <gtest/gtest.h>
 
 // Standard library header files:
-#include <cstdlib>   // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cctype>    // For isdigit.
+#include <cerrno>    // For errno and ERANGE.
+#include <cmath>     // For isfinite.
+#include <cstdio>    // For FILE, fdopen and fprintf.
+#include <cstdlib>   // For EXIT_SUCCESS, EXIT_FAILURE, strtod, strtoll, setenv
 #include <cstring>   // For strncmp
+#include <fstream>
 #include <iostream>  // For cerr.
+#include <iterator>  // For istreambuf_iterator.
+#include <limits>    // For numeric_limits.
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
 
-int main(int argc, char** argv) {
-  ::testing::InitGoogleTest(&argc, argv);
+#ifndef _WIN32
+#include <sys/wait.h>  // For waitpid.
+#include <unistd.h>    // For fork and pipe.
+#endif
 
-  auto* const unit_test = testing::UnitTest::GetInstance();
+namespace {
 
-  if (unit_test == nullptr) {
-    std::cerr << "UnitTest::GetInstance() failed\n";
-    return EXIT_FAILURE;
+struct TestOutcome {
+  std::string full_name;  // "<test suite name>.<test name>"
+  bool is_failed;
+  long long elapsed_ms;
+
+  // Returns the name of the test, following the last '.' of the full name, as
+  // the name of a test suite may contain a '.', but the name of a test may not.
+  const char* GetTestName() const {
+    return full_name.c_str() + full_name.rfind('.') + 1;
   }
+};
 
-  if (unit_test->Run() != 1) {
-    // Run() returns 1 when there are any test failures.
-    std::cerr << "UnitTest::Run() should return 1, as this program has "
-                 "intended test failures!\n";
-    return EXIT_FAILURE;
+// Tells whether the result of a test is as expected: only the tests whose
+// name starts with "Irregular" (possibly preceded by "DISABLED_") should fail.
+// Reports the test otherwise.
+bool IsTestResultAsExpected(const char* test_name, const bool is_failed) {
+  const char prefix_of_disabled_tests[] = "DISABLED_";
+  const char prefix_of_tests_that_should_fail[] = "Irregular";
+
+  if (std::strncmp(test_name, prefix_of_disabled_tests,
+                   sizeof(prefix_of_disabled_tests) - 1) == 0) {
+    test_name += sizeof(prefix_of_disabled_tests) - 1;
+  }
+  const bool should_test_fail =
+      std::strncmp(test_name, prefix_of_tests_that_should_fail,
+                   sizeof(prefix_of_tests_that_should_fail) - 1) == 0;
+
+  if (is_failed != should_test_fail) {
+    std::cerr << (should_test_fail ? "A test unexpectedly passed successfully: "
+                                   : "A test unexpectedly failed: ")
+              << test_name << '\n';
+    return false;
   }
+  return true;
+}
 
+// Adds the outcome of each test that has run to the specified vector. Returns
+// false when the reflection API unexpectedly returns null.
+bool CollectTestOutcomes(const testing::UnitTest& unit_test,
+                         std::vector<TestOutcome>& outcomes) {
   // The following is adapted from the example of using the UnitTest reflection
   // API (Copyright 2009 Google Inc.), from
   // https://github.com/google/googletest/blob/release-1.10.0/googletest/samples/sample9_unittest.cc#L135-L149
 
-  const int test_suite_count{unit_test->total_test_suite_count()};
+  const int test_suite_count{unit_test.total_test_suite_count()};
 
   for (int i = 0; i < test_suite_count; ++i) {
-    const testing::TestSuite* const test_suite = unit_test->GetTestSuite(i);
+    const testing::TestSuite* const test_suite = unit_test.GetTestSuite(i);
     if (test_suite == nullptr) {
       std::cerr << "UnitTest::GetTestSuite(i) unexpectedly returned null!\n";
-      return EXIT_FAILURE;
+      return false;
     }
     const int test_count = test_suite->total_test_count();
     for (int j = 0; j < test_count; ++j) {
@@ -74,7 +141,7 @@ int main(int argc, char** argv) {
 
       if (test_info == nullptr) {
         std::cerr << "TestSuite::GetTestInfo(j) unexpectedly returned null!\n";
-        return EXIT_FAILURE;
+        return false;
       }
 
       const char* const test_name = test_info->name();
@@ -83,23 +150,472 @@ int main(int argc, char** argv) {
       if ((test_name == nullptr) || (test_result == nullptr)) {
         std::cerr
             << "TestInfo name() or result() unexpectedly returned null!\n";
-        return EXIT_FAILURE;
+        return false;
+      }
+      if (test_info->should_run()) {
+        outcomes.push_back(
+            {std::string(test_suite->name()) + '.' + test_name,
+             test_result->Failed(),
+             static_cast<long long>(test_result->elapsed_time())});
+      }
+    }
+  }
+  return true;
+}
+
+bool RunInThisProcess(testing::UnitTest& unit_test,
+                      std::vector<TestOutcome>& outcomes) {
+  if (unit_test.Run() != 1) {
+    // Run() returns 1 when there are any test failures.
+    std::cerr << "UnitTest::Run() should return 1, as this program has "
+                 "intended test failures!\n";
+    return false;
+  }
+  return CollectTestOutcomes(unit_test, outcomes);
+}
+
+#ifndef _WIN32
+
+// Returns the GoogleTest output specification (like "xml:report.xml") for the
+// shard with the specified index, so that the workers do not overwrite each
+// other's output file. Adds ".shard<index>" to the file name, before its
+// extension, or a "shard<index>" subdirectory to an output directory.
+std::string GetShardOutput(const std::string& output,
+                           const unsigned job_index) {
+  const std::string shard = "shard" + std::to_string(job_index);
+  const std::size_t colon = output.find(':');
+
+  if (colon == std::string::npos) {
+    // Only the format is specified, like "xml", so GoogleTest would write
+    // "test_detail.xml".
+    return output + ":test_detail." + shard + '.' + output;
+  }
+  const char last = output.back();
+
+  if (last == '/' || last == '\\') {
+    return output + shard + last;
+  }
+  const std::size_t dot = output.rfind('.');
+  const std::size_t separator = output.find_last_of("/\\");
+
+  if (dot == std::string::npos || dot < colon ||
+      (separator != std::string::npos && dot < separator)) {
+    return output + '.' + shard;
+  }
+  return output.substr(0, dot) + '.' + shard + output.substr(dot);
+}
+
+// Runs the shard of the tests with the specified index, in a worker process,
+// and writes a line for each test that has run to the specified file
+// descriptor: the full name of the test, a tab, 1 when it failed or 0 when it
+// passed, a tab, and its elapsed time in milliseconds. Does not return.
+[[noreturn]] void RunWorker(int argc, char** const argv,
+                            const unsigned job_count,
+                            const unsigned job_index, const int fd) {
+  setenv("GTEST_TOTAL_SHARDS", std::to_string(job_count).c_str(), 1);
+  setenv("GTEST_SHARD_INDEX", std::to_string(job_index).c_str(), 1);
+
+  const char output_option[] = "--gtest_output=";
+  std::string output_arg;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], output_option, sizeof(output_option) - 1) ==
+        0) {
+      output_arg = output_option +
+                   GetShardOutput(argv[i] + sizeof(output_option) - 1,
+                                  job_index);
+      argv[i] = &output_arg[0];
+    }
+  }
+  // The output flag may already be set here, by GTEST_OUTPUT.
+  const std::string output_flag = GTEST_FLAG_GET(output);
+
+  if (!output_flag.empty()) {
+    GTEST_FLAG_SET(output, GetShardOutput(output_flag, job_index));
+  }
+
+  // GoogleTest is initialized by the worker, rather than before the fork, as
+  // it only reads the output file name while being initialized.
+  ::testing::InitGoogleTest(&argc, argv);
+  testing::UnitTest& unit_test = *testing::UnitTest::GetInstance();
+
+  // The result of Run() is ignored here, as it is the result of the tests of
+  // all the workers together that matters.
+  const int run_result{unit_test.Run()};
+  static_cast<void>(run_result);
+
+  std::vector<TestOutcome> outcomes;
+  FILE* const file = fdopen(fd, "w");
+  bool is_success =
+      (file != nullptr) && CollectTestOutcomes(unit_test, outcomes);
+
+  for (const TestOutcome& outcome : outcomes) {
+    is_success = is_success &&
+                 std::fprintf(file, "%s\t%d\t%lld\n", outcome.full_name.c_str(),
+                              outcome.is_failed ? 1 : 0,
+                              outcome.elapsed_ms) > 0;
+  }
+  is_success = (file != nullptr) && (std::fclose(file) == 0) && is_success;
+  std::exit(is_success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+bool RunInWorkerProcesses(const int argc, char** const argv,
+                          const unsigned job_count,
+                          std::vector<TestOutcome>& outcomes) {
+  struct Worker {
+    pid_t pid;
+    int fd;
+  };
+  std::vector<Worker> workers;
+
+  for (unsigned job_index{}; job_index < job_count; ++job_index) {
+    int fds[2];
+
+    if (pipe(fds) != 0) {
+      std::cerr << "pipe() failed!\n";
+      return false;
+    }
+    // Flush before forking, to avoid duplicate output.
+    std::cout.flush();
+    std::fflush(nullptr);
+    const pid_t pid = fork();
+
+    if (pid < 0) {
+      std::cerr << "fork() failed!\n";
+      return false;
+    }
+    if (pid == 0) {
+      close(fds[0]);
+      for (const Worker& worker : workers) {
+        close(worker.fd);
       }
+      RunWorker(argc, argv, job_count, job_index, fds[1]);
+    }
+    close(fds[1]);
+    workers.push_back({pid, fds[0]});
+  }
+
+  bool is_success{true};
+
+  for (const Worker& worker : workers) {
+    std::string output;
+    char buffer[4096];
 
-      const char prefix_of_tests_that_should_fail[] = "Irregular";
-      const bool should_test_fail =
-          std::strncmp(test_name, prefix_of_tests_that_should_fail,
-                       sizeof(prefix_of_tests_that_should_fail) - 1) == 0;
-
-      if (test_result->Failed() != should_test_fail) {
-        std::cerr << (should_test_fail
-                          ? "A test unexpectedly passed successfully: "
-                          : "A test unexpectedly failed: ")
-                  << test_name << '\n';
-        return EXIT_FAILURE;
+    for (ssize_t size; (size = read(worker.fd, buffer, sizeof(buffer))) > 0;) {
+      output.append(buffer, static_cast<std::size_t>(size));
+    }
+    close(worker.fd);
+
+    int status{};
+
+    if ((waitpid(worker.pid, &status, 0) != worker.pid) ||
+        !WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS)) {
+      std::cerr << "A worker process did not complete successfully!\n";
+      is_success = false;
+    }
+
+    std::istringstream lines(output);
+    std::string line;
+
+    while (std::getline(lines, line)) {
+      std::istringstream fields(line);
+      TestOutcome outcome{};
+      int is_failed{};
+
+      if (!std::getline(fields, outcome.full_name, '\t') ||
+          !(fields >> is_failed >> outcome.elapsed_ms)) {
+        std::cerr << "Unexpected output from a worker process!\n";
+        return false;
       }
+      outcome.is_failed = is_failed != 0;
+      outcomes.push_back(outcome);
     }
   }
 
-  return EXIT_SUCCESS;
+  bool has_any_test_failed{false};
+
+  for (const TestOutcome& outcome : outcomes) {
+    has_any_test_failed = has_any_test_failed || outcome.is_failed;
+  }
+  if (!has_any_test_failed) {
+    std::cerr << "At least one test should fail, as this program has "
+                 "intended test failures!\n";
+    return false;
+  }
+  return is_success;
+}
+
+#endif
+
+bool AreTestResultsAsExpected(const std::vector<TestOutcome>& outcomes) {
+  bool is_as_expected{true};
+
+  for (const TestOutcome& outcome : outcomes) {
+    is_as_expected =
+        IsTestResultAsExpected(outcome.GetTestName(), outcome.is_failed) &&
+        is_as_expected;
+  }
+  return is_as_expected;
+}
+
+// Writes the specified text as a JSON string, escaping its quotes and
+// backslashes. Test names do not have other characters that need escaping.
+void WriteJsonString(std::ostream& stream, const std::string& text) {
+  stream << '"';
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      stream << '\\';
+    }
+    stream << c;
+  }
+  stream << '"';
+}
+
+bool WriteTimingReport(const char* const file_name,
+                       const std::vector<TestOutcome>& outcomes) {
+  std::ofstream file(file_name);
+  const char* separator = "\n";
+
+  file << '{';
+  for (const TestOutcome& outcome : outcomes) {
+    file << separator << "  ";
+    WriteJsonString(file, outcome.full_name);
+    file << ": " << outcome.elapsed_ms;
+    separator = ",\n";
+  }
+  file << "\n}\n";
+
+  if (!file.flush()) {
+    std::cerr << "Failed to write the timing report: " << file_name << '\n';
+    return false;
+  }
+  return true;
+}
+
+// Reads a JSON string, as written by WriteJsonString, starting at the specified
+// opening quote. Returns the position just after its closing quote, or npos
+// when the string is not terminated.
+std::size_t ReadJsonString(const std::string& text, std::size_t position,
+                           std::string& result) {
+  result.clear();
+
+  for (++position; position < text.size(); ++position) {
+    if (text[position] == '"') {
+      return position + 1;
+    }
+    if (text[position] == '\\') {
+      ++position;
+      if (position == text.size()) {
+        break;
+      }
+    }
+    result += text[position];
+  }
+  return std::string::npos;
+}
+
+// Reads a timing report, as written by WriteTimingReport. Only supports the
+// format of such a report, rather than JSON in general.
+bool ReadTimingReport(const char* const file_name,
+                      std::map<std::string, long long>& elapsed_times) {
+  std::ifstream file(file_name);
+
+  if (!file) {
+    std::cerr << "Failed to read the timing baseline: " << file_name << '\n';
+    return false;
+  }
+  const std::string text{std::istreambuf_iterator<char>(file),
+                         std::istreambuf_iterator<char>()};
+
+  std::string test_name;
+
+  for (std::size_t begin = text.find('"'); begin != std::string::npos;
+       begin = text.find('"', begin)) {
+    const std::size_t end = ReadJsonString(text, begin, test_name);
+    const std::size_t colon = text.find(':', end);
+
+    if ((end == std::string::npos) || (colon == std::string::npos)) {
+      std::cerr << "Unexpected format of the timing baseline: " << file_name
+                << '\n';
+      return false;
+    }
+    elapsed_times[test_name] =
+        std::strtoll(text.c_str() + colon + 1, nullptr, 10);
+    begin = colon + 1;
+  }
+  return true;
+}
+
+// Checks that the elapsed time of each test does not exceed the specified
+// ratio of its elapsed time in the baseline. Reports each test that does.
+bool IsTimingWithinBaseline(const char* const baseline_file_name,
+                            const double ratio, const long long min_ms,
+                            const std::vector<TestOutcome>& outcomes) {
+  std::map<std::string, long long> baseline;
+
+  if (!ReadTimingReport(baseline_file_name, baseline)) {
+    return false;
+  }
+  bool is_within_baseline{true};
+
+  for (const TestOutcome& outcome : outcomes) {
+    const auto found = baseline.find(outcome.full_name);
+
+    if (found != baseline.end()) {
+      const long long baseline_ms =
+          (found->second < min_ms) ? min_ms : found->second;
+
+      if (static_cast<double>(outcome.elapsed_ms) >
+          ratio * static_cast<double>(baseline_ms)) {
+        std::cerr << "A test became unexpectedly slow: " << outcome.full_name
+                  << " (" << outcome.elapsed_ms << " ms, baseline "
+                  << found->second << " ms)\n";
+        is_within_baseline = false;
+      }
+    }
+  }
+  return is_within_baseline;
+}
+
+// Returns the value of the specified option (like "--jobs="), or null when the
+// option is not specified.
+const char* FindOptionValue(const int argc, char** const argv,
+                            const char* const option) {
+  const std::size_t option_length = std::strlen(option);
+  const char* value{};
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], option, option_length) == 0) {
+      value = argv[i] + option_length;
+    }
+  }
+  return value;
+}
+
+// Parses the value of --jobs=N. Returns false when it is not a positive
+// number.
+bool ParseJobCount(const char* const jobs, unsigned& job_count) {
+  if (!std::isdigit(static_cast<unsigned char>(*jobs))) {
+    return false;
+  }
+  char* end{};
+  errno = 0;
+  const unsigned long value = std::strtoul(jobs, &end, 10);
+
+  if (*end != '\0' || errno == ERANGE || value == 0 ||
+      value > std::numeric_limits<unsigned>::max()) {
+    return false;
+  }
+  job_count = static_cast<unsigned>(value);
+  return true;
+}
+
+// Parses the value of --timing_ratio=R. Returns false when it is not a positive
+// finite number.
+bool ParseTimingRatio(const char* const ratio_text, double& ratio) {
+  if (!std::isdigit(static_cast<unsigned char>(*ratio_text)) &&
+      *ratio_text != '.') {
+    return false;
+  }
+  char* end{};
+  errno = 0;
+  const double value = std::strtod(ratio_text, &end);
+
+  if (*end != '\0' || errno == ERANGE || !(value > 0.0) ||
+      !std::isfinite(value)) {
+    return false;
+  }
+  ratio = value;
+  return true;
+}
+
+// Parses the value of --timing_min_ms=M. Returns false when it is not a
+// non-negative number.
+bool ParseMinMs(const char* const min_ms_text, long long& min_ms) {
+  if (!std::isdigit(static_cast<unsigned char>(*min_ms_text))) {
+    return false;
+  }
+  char* end{};
+  errno = 0;
+  const long long value = std::strtoll(min_ms_text, &end, 10);
+
+  if (*end != '\0' || errno == ERANGE) {
+    return false;
+  }
+  min_ms = value;
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* const jobs = FindOptionValue(argc, argv, "--jobs=");
+  unsigned job_count{1};
+
+  if (jobs != nullptr && !ParseJobCount(jobs, job_count)) {
+    std::cerr << "Invalid --jobs value: \"" << jobs
+              << "\" (expected a positive number)\n";
+    return EXIT_FAILURE;
+  }
+
+  const char* const ratio_text = FindOptionValue(argc, argv, "--timing_ratio=");
+  double ratio{2.0};
+
+  if (ratio_text != nullptr && !ParseTimingRatio(ratio_text, ratio)) {
+    std::cerr << "Invalid --timing_ratio value: \"" << ratio_text
+              << "\" (expected a positive number)\n";
+    return EXIT_FAILURE;
+  }
+
+  const char* const min_ms_text =
+      FindOptionValue(argc, argv, "--timing_min_ms=");
+  long long min_ms{10};
+
+  if (min_ms_text != nullptr && !ParseMinMs(min_ms_text, min_ms)) {
+    std::cerr << "Invalid --timing_min_ms value: \"" << min_ms_text
+              << "\" (expected a non-negative number)\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<TestOutcome> outcomes;
+  bool is_success{};
+
+#ifndef _WIN32
+  if (job_count > 1) {
+    // Each worker process initializes GoogleTest by itself.
+    is_success = RunInWorkerProcesses(argc, argv, job_count, outcomes);
+  } else
+#endif
+  {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    auto* const unit_test = testing::UnitTest::GetInstance();
+
+    if (unit_test == nullptr) {
+      std::cerr << "UnitTest::GetInstance() failed\n";
+      return EXIT_FAILURE;
+    }
+#ifdef _WIN32
+    if (job_count > 1) {
+      std::cerr << "Note: --jobs is not supported on this platform.\n";
+    }
+#endif
+    is_success = RunInThisProcess(*unit_test, outcomes);
+  }
+  is_success = is_success && AreTestResultsAsExpected(outcomes);
+
+  const char* const report = FindOptionValue(argc, argv, "--timing_report=");
+
+  if (report != nullptr) {
+    is_success = WriteTimingReport(report, outcomes) && is_success;
+  }
+
+  const char* const baseline =
+      FindOptionValue(argc, argv, "--timing_baseline=");
+
+  if (baseline != nullptr) {
+    is_success = IsTimingWithinBaseline(baseline, ratio, min_ms, outcomes) &&
+                 is_success;
+  }
+  return is_success ? EXIT_SUCCESS : EXIT_FAILURE;
 }